@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    CachedLayer.h
+    Created: 16 Oct 2026 11:02:15pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** A static part of a component, rendered once to an image and then drawn
+    with a single blit.
+
+    The image has the physical resolution of the context it is drawn to, so
+    it stays sharp on high-DPI displays and at any host scale. It is rendered
+    again when the size of the area or the scale changes, or after
+    invalidate().
+*/
+class CachedLayer
+{
+public:
+    /** Draws the layer over area, first calling paintLayer to render it if
+        needed. paintLayer gets a context whose origin is the top-left of area.
+    */
+    template <typename PaintFunction>
+    void draw(juce::Graphics& g, juce::Rectangle<int> area, PaintFunction&& paintLayer)
+    {
+        if (area.isEmpty())
+            return;
+
+        const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+        if (! image.isValid() || area.getWidth() != width || area.getHeight() != height || scale != imageScale)
+        {
+            width = area.getWidth();
+            height = area.getHeight();
+            imageScale = scale;
+
+            image = juce::Image(juce::Image::ARGB,
+                                juce::jmax(1, juce::roundToInt((float) width * scale)),
+                                juce::jmax(1, juce::roundToInt((float) height * scale)),
+                                true);
+
+            juce::Graphics imageGraphics(image);
+            imageGraphics.addTransform(juce::AffineTransform::scale((float) image.getWidth() / (float) width,
+                                                                    (float) image.getHeight() / (float) height));
+            paintLayer(imageGraphics);
+        }
+
+        // One image pixel per physical pixel: no resampling needed
+        const juce::Graphics::ScopedSaveState state(g);
+        g.setOpacity(1.0f);
+        g.setImageResamplingQuality(juce::Graphics::lowResamplingQuality);
+        g.drawImage(image, area.toFloat());
+    }
+
+    /** Renders the layer again on the next draw. */
+    void invalidate() noexcept { image = {}; }
+
+private:
+    juce::Image image;
+    int width = 0;
+    int height = 0;
+    float imageScale = 1.0f;
+};
@@ -26,6 +26,11 @@ FxmeLogo::~FxmeLogo()
 }
 
 void FxmeLogo::paint (juce::Graphics& g)
+{
+    cachedLogo.draw(g, getLocalBounds(), [this] (juce::Graphics& layer) { paintLogo(layer); });
+}
+
+void FxmeLogo::paintLogo (juce::Graphics& g)
 {
     float fac = 1.f;
     if (logo.isValid())
@@ -41,6 +46,7 @@ void FxmeLogo::paint (juce::Graphics& g)
                                                  bounds.getY()+size*(RATIO-1)/2.f,
                                                  size,
                                                  size/RATIO);
+        g.setImageResamplingQuality(juce::Graphics::highResamplingQuality);
         g.drawImage(logo, logoBounds);
     }
 
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "CachedLayer.h"
 
 #define RATIO 1.185f
 
@@ -32,7 +33,10 @@ public:
     std::function<void()> onClick;
 
 private:
+    void paintLogo (juce::Graphics&);
+
     juce::Image logo;
+    CachedLayer cachedLogo; // The logo rescaled to the current size and scale
     juce::String titleText;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FxmeLogo)
 };
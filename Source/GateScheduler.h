@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+    GateScheduler.h
+    Created: 16 Oct 2026 10:12:04am
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** A run of samples during which the step and the open/closed state of the
+    gate do not change.
+*/
+struct GateSegment
+{
+    int step;       // Step index within the sequence
+    bool open;      // True if the gate targets 1 during the segment
+    int endSample;  // One past the last sample of the segment
+};
+
+//==============================================================================
+/** Computes, from the transport position, the sample offsets at which the
+    gate changes state (step boundaries and duration cut-offs).
+    This lets processBlock render whole segments instead of resolving the
+    step and its progress for every sample.
+
+    The span of the last segment, in PPQ, is kept from one call to the next:
+    as long as the position stays inside it, which is the common case with
+    small blocks, the next segment costs no division nor fmod. Call
+    invalidate() when the steps change.
+
+    The span edges are computed differently from the per-sample position of
+    the step (floor and multiply instead of fmod and divide), so a sample
+    lying within rounding of an edge could end up on the other side of it.
+    Such samples are settled with getStateAt(), which keeps the segments
+    identical to a sample by sample evaluation.
+*/
+class GateScheduler
+{
+public:
+    void setTiming(double newStepDurationInPpq, int newNumSteps) noexcept
+    {
+        newNumSteps = juce::jmax(1, newNumSteps);
+
+        if (newStepDurationInPpq != stepDurationInPpq || newNumSteps != numSteps)
+        {
+            stepDurationInPpq = newStepDurationInPpq;
+            numSteps = newNumSteps;
+            invalidate();
+        }
+    }
+
+    double getStepDurationInPpq() const noexcept { return stepDurationInPpq; }
+    int getNumSteps() const noexcept { return numSteps; }
+
+    /** Forgets the cached segment, after a change of the steps' on/off state or duration. */
+    void invalidate() noexcept { lastSpan = {}; }
+
+    /** Returns the step playing at the given PPQ position. */
+    int getStepAt(double ppq) const noexcept
+    {
+        return juce::jlimit(0, numSteps - 1, (int) (wrap(ppq, numSteps * stepDurationInPpq) / stepDurationInPpq));
+    }
+
+    /** A step and the PPQ range during which it plays. */
+    struct StepSpan
+    {
+        int step = -1;
+        double startPpq = 0.0;
+        double endPpq = -1.0;
+
+        bool contains(double ppq) const noexcept { return ppq >= startPpq && ppq < endPpq; }
+    };
+
+    /** Returns the step playing at the given PPQ position, and its range. */
+    StepSpan getStepSpanAt(double ppq) const noexcept
+    {
+        const double absoluteStep = std::floor(ppq / stepDurationInPpq);
+        const double startPpq = absoluteStep * stepDurationInPpq;
+
+        int step = (int) std::fmod(absoluteStep, (double) numSteps);
+        step = juce::jlimit(0, numSteps - 1, step < 0 ? step + numSteps : step);
+
+        return { step, startPpq, startPpq + stepDurationInPpq };
+    }
+
+    /** Returns the segment starting at startSample.
+        lookup(step) must return a std::pair<bool, float> holding the on/off
+        state and the duration (fraction of the step) of the given step.
+    */
+    template <typename StepLookup>
+    GateSegment getSegment(double blockPpq, double ppqPerSample,
+                            int startSample, int numSamples,
+                            StepLookup&& lookup) noexcept
+    {
+        return findSegment(numSteps, blockPpq, ppqPerSample, startSample, numSamples, lookup);
+    }
+
+private:
+    // A segment, as the PPQ range during which the gate keeps its step and state
+    struct SegmentSpan
+    {
+        int step = 0;
+        bool open = false;
+        double startPpq = 0.0;
+        double endPpq = -1.0;
+    };
+
+    template <typename StepLookup>
+    JUCE_FORCE_INLINE GateSegment findSegment(int stepCount, double blockPpq, double ppqPerSample,
+                                               int startSample, int numSamples,
+                                               StepLookup& lookup) noexcept
+    {
+        const double ppq = blockPpq + startSample * ppqPerSample;
+
+        if (! (ppq >= lastSpan.startPpq && ppq < lastSpan.endPpq))
+            lastSpan = computeSpan(stepCount, ppq, lookup);
+
+        // A first sample within rounding of an edge may still belong to the
+        // neighbouring segment; it then makes a segment of its own
+        if (isNearEdge(ppq, lastSpan.startPpq) || isNearEdge(ppq, lastSpan.endPpq))
+        {
+            const auto state = getStateAt(stepCount, ppq, lookup);
+            if (state.step != lastSpan.step || state.open != lastSpan.open)
+                return { state.step, state.open, startSample + 1 };
+        }
+
+        int endSample = numSamples;
+        if (ppqPerSample > 0.0)
+        {
+            // First sample whose position reaches the end of the segment
+            const double samplesToEnd = std::ceil((lastSpan.endPpq - blockPpq) / ppqPerSample);
+            if (samplesToEnd < (double) numSamples)
+                endSample = juce::jmax(startSample + 1, (int) samplesToEnd);
+
+            // The sample before it may already be past the edge, by rounding
+            const double lastSample = samplesToEnd - 1.0;
+            if (lastSample > (double) startSample && lastSample < (double) numSamples)
+            {
+                const double lastPpq = blockPpq + (int) lastSample * ppqPerSample;
+                if (isNearEdge(lastPpq, lastSpan.endPpq))
+                {
+                    const auto state = getStateAt(stepCount, lastPpq, lookup);
+                    if (state.step != lastSpan.step || state.open != lastSpan.open)
+                        endSample = (int) lastSample;
+                }
+            }
+        }
+
+        return { lastSpan.step, lastSpan.open, endSample };
+    }
+
+    // The step and state at a position, from the sequence position as a
+    // sample by sample render would compute them
+    template <typename StepLookup>
+    GateSegment getStateAt(int stepCount, double ppq, StepLookup& lookup) const noexcept
+    {
+        const double sequencePpq = wrap(ppq, stepCount * stepDurationInPpq);
+        const int step = juce::jlimit(0, stepCount - 1, (int) (sequencePpq / stepDurationInPpq));
+        const double stepProgress = std::fmod(sequencePpq, stepDurationInPpq) / stepDurationInPpq;
+
+        const auto [isOn, duration] = lookup(step);
+        return { step, isOn && stepProgress < duration, 0 };
+    }
+
+    // Far larger than the rounding of the span edges, far smaller than a sample
+    static bool isNearEdge(double ppq, double edgePpq) noexcept
+    {
+        return std::abs(ppq - edgePpq) <= 1.0e-12 * juce::jmax(1.0, std::abs(ppq));
+    }
+
+    template <typename StepLookup>
+    JUCE_FORCE_INLINE SegmentSpan computeSpan(int stepCount, double ppq, StepLookup& lookup) const noexcept
+    {
+        // The span only depends on the step the position falls in, not on the
+        // position itself, so it is the same whichever of its samples a
+        // render starts from
+        const double absoluteStep = std::floor(ppq / stepDurationInPpq);
+        const double stepStartPpq = absoluteStep * stepDurationInPpq;
+
+        int step = (int) std::fmod(absoluteStep, (double) stepCount);
+        step = juce::jlimit(0, stepCount - 1, step < 0 ? step + stepCount : step);
+
+        // How far into the current step we are (0.0 to 1.0)
+        const double stepProgress = (ppq - stepStartPpq) / stepDurationInPpq;
+
+        const auto [isOn, duration] = lookup(step);
+        const bool open = isOn && stepProgress < duration;
+
+        // The gate closes at the duration cut-off, or changes step at the step boundary
+        const double fractionAtStart = isOn && ! open ? (double) duration : 0.0;
+        const double fractionAtEnd = open ? juce::jmin(1.0, (double) duration) : 1.0;
+
+        return { step, open,
+                 stepStartPpq + fractionAtStart * stepDurationInPpq,
+                 stepStartPpq + fractionAtEnd * stepDurationInPpq };
+    }
+
+    static double wrap(double ppq, double sequenceDurationInPpq) noexcept
+    {
+        auto sequencePpq = std::fmod(ppq, sequenceDurationInPpq);
+        return sequencePpq < 0.0 ? sequencePpq + sequenceDurationInPpq : sequencePpq;
+    }
+
+    double stepDurationInPpq = 0.25;
+    int numSteps = 16;
+    SegmentSpan lastSpan;
+};
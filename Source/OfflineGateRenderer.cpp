@@ -0,0 +1,270 @@
+/*
+  ==============================================================================
+
+    OfflineGateRenderer.cpp
+    Created: 16 Oct 2026 6:05:33pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#include "OfflineGateRenderer.h"
+
+OfflineGateRenderer::OfflineGateRenderer(RhythmicGateAudioProcessor& processor, const juce::AudioChannelSet& channelSet,
+                                         double rate, double bpm, double ppqAtStart)
+    : sampleRate(rate),
+      ppqPerSample(bpm / (rate * 60.0)),
+      startPpq(ppqAtStart)
+{
+    auto& apvts = processor.apvts;
+    auto getValue = [&apvts] (const juce::String& paramID) { return apvts.getRawParameterValue(paramID)->load(); };
+
+    const auto& metrics = RhythmicGateAudioProcessor::getMetrics();
+    const int metricIndex = static_cast<int>(getValue("METRIC"));
+    stepDurationInPpq = juce::isPositiveAndBelow(metricIndex, (int) metrics.size())
+                        ? metrics[(size_t) metricIndex].duration
+                        : 0.25; // Default fallback
+
+    numSteps = static_cast<int>(getValue("STEPS"));
+    attackMs = getValue("ATTACK");
+    releaseMs = getValue("RELEASE");
+
+    for (int step = 0; step < RhythmicGateAudioProcessor::NUM_STEPS; ++step)
+        steps.setStep(step,
+                      getValue(ParameterID::get(step, "ON")),
+                      getValue(ParameterID::get(step, "DUR")),
+                      getValue(ParameterID::get(step, "LVL")),
+                      getValue(ParameterID::get(step, "AUX_LVL")),
+                      getValue(ParameterID::get(step, "PAN")));
+
+    for (int channel = 0; channel < channelSet.size(); ++channel)
+        panGroupOfChannel.push_back(getPanGroup(channelSet.getTypeOfChannel(channel)));
+}
+
+//==============================================================================
+void OfflineGateRenderer::render(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& mainOutput,
+                                 juce::AudioBuffer<float>& auxOutput, juce::int64 timelineSample) const
+{
+    EnvelopeState state;
+    render(input, mainOutput, auxOutput, timelineSample, state);
+}
+
+void OfflineGateRenderer::render(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& mainOutput,
+                                 juce::AudioBuffer<float>& auxOutput, juce::int64 timelineSample, EnvelopeState& state) const
+{
+    const int numSamples = input.getNumSamples();
+    const int numChannels = juce::jmin(input.getNumChannels(), mainOutput.getNumChannels(), (int) panGroupOfChannel.size());
+    const bool withAux = auxOutput.getNumChannels() > 0;
+    jassert(mainOutput.getNumSamples() >= numSamples && (! withAux || auxOutput.getNumChannels() >= numChannels));
+
+    if (state.position != timelineSample)
+        state = getEnvelopeStateAt(timelineSample);
+
+    state.position = timelineSample + numSamples;
+
+    juce::AudioBuffer<float> gateBuffer(1, maxRunLength);
+    juce::AudioBuffer<float> mainEnvelopeBuffer(numPanGroups, maxRunLength);
+    juce::AudioBuffer<float> auxEnvelopeBuffer(withAux ? numPanGroups : 0, maxRunLength);
+    auto* gate = gateBuffer.getWritePointer(0);
+
+    forEachSegment(timelineSample, timelineSample + numSamples,
+                   [&] (juce::int64 segmentStart, juce::int64 segmentEnd, const GateSegment& segment)
+    {
+        setGateTarget(state, segment.open ? 1.0f : 0.0f);
+
+        const float mainLevel = steps.mainGain[segment.step];
+        const float auxLevel = steps.auxGain[segment.step];
+        const int end = (int) (segmentEnd - timelineSample);
+
+        for (int runStart = (int) (segmentStart - timelineSample); runStart < end;)
+        {
+            const int runLength = juce::jmin(maxRunLength, end - runStart);
+
+            // Gate envelope: only the attack/release ramp needs the smoother sample by sample
+            int sample = 0;
+            while (sample < runLength && state.smoother.isSmoothing())
+                gate[sample++] = state.smoother.getNextValue();
+
+            // Once the gate has settled closed, the rest of the run is cleared
+            const float settledGain = state.smoother.getCurrentValue();
+            const int envelopeLength = settledGain == 0.0f ? sample : runLength;
+            juce::FloatVectorOperations::fill(gate + sample, settledGain, envelopeLength - sample);
+
+            for (int group = 0; group < numPanGroups; ++group)
+            {
+                const float panGain = steps.panGains[(size_t) group][segment.step];
+                juce::FloatVectorOperations::multiply(mainEnvelopeBuffer.getWritePointer(group), gate, mainLevel * panGain, envelopeLength);
+                if (withAux)
+                    juce::FloatVectorOperations::multiply(auxEnvelopeBuffer.getWritePointer(group), gate, auxLevel * panGain, envelopeLength);
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const int group = panGroupOfChannel[(size_t) channel];
+                const auto* in = input.getReadPointer(channel, runStart);
+
+                // The main output may be the input, so write the aux first
+                if (withAux)
+                {
+                    auto* aux = auxOutput.getWritePointer(channel, runStart);
+                    juce::FloatVectorOperations::multiply(aux, in, auxEnvelopeBuffer.getReadPointer(group), envelopeLength);
+                    juce::FloatVectorOperations::clear(aux + envelopeLength, runLength - envelopeLength);
+                }
+
+                auto* main = mainOutput.getWritePointer(channel, runStart);
+                juce::FloatVectorOperations::multiply(main, in, mainEnvelopeBuffer.getReadPointer(group), envelopeLength);
+                juce::FloatVectorOperations::clear(main + envelopeLength, runLength - envelopeLength);
+            }
+
+            runStart += runLength;
+        }
+    });
+}
+
+void OfflineGateRenderer::renderParallel(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& mainOutput,
+                                         juce::AudioBuffer<float>& auxOutput, juce::int64 timelineSample,
+                                         juce::ThreadPool& pool, int chunkSize) const
+{
+    const int numSamples = input.getNumSamples();
+    const int numChunks = (numSamples + chunkSize - 1) / chunkSize;
+    if (numChunks == 0)
+        return;
+
+    // A range of samples of a buffer, without copying them. The write pointers
+    // of the outputs are taken once, here: they also mark the outputs as not clear.
+    auto getRange = [] (float* const* channels, int numChannels, int start, int length)
+    {
+        return juce::AudioBuffer<float>(channels, numChannels, start, length);
+    };
+
+    auto* const* inputChannels = const_cast<float* const*>(input.getArrayOfReadPointers()); // Only read
+    auto* const* mainChannels = mainOutput.getArrayOfWritePointers();
+    auto* const* auxChannels = auxOutput.getArrayOfWritePointers();
+
+    std::atomic<int> numPendingChunks { numChunks };
+    juce::WaitableEvent allChunksRendered;
+
+    for (int chunk = 0; chunk < numChunks; ++chunk)
+    {
+        pool.addJob([&, chunk]
+        {
+            const int start = chunk * chunkSize;
+            const int length = juce::jmin(chunkSize, numSamples - start);
+
+            const auto chunkInput = getRange(inputChannels, input.getNumChannels(), start, length);
+            auto chunkMain = getRange(mainChannels, mainOutput.getNumChannels(), start, length);
+            auto chunkAux = getRange(auxChannels, auxOutput.getNumChannels(), start, length);
+            render(chunkInput, chunkMain, chunkAux, timelineSample + start);
+
+            if (--numPendingChunks == 0)
+                allChunksRendered.signal();
+        });
+    }
+
+    allChunksRendered.wait();
+}
+
+//==============================================================================
+OfflineGateRenderer::EnvelopeState OfflineGateRenderer::getEnvelopeStateAt(juce::int64 timelineSample) const
+{
+    // Every change of target resets the smoother, which snaps it to the
+    // previous target: from then on, the envelope does not depend on what
+    // came before, and it reaches the new target within the longest ramp.
+    // So only the samples within one ramp of the position are looked at:
+    // - with a change of target there, the envelope is replayed from it;
+    // - with the same target all along, the envelope has settled on it;
+    // - near the start of the timeline, it is replayed from the start.
+    const auto settleLength = (juce::int64) std::ceil(juce::jmax(attackMs, releaseMs) * 0.001 * sampleRate) + 1;
+    const auto from = juce::jmax((juce::int64) 0, timelineSample - settleLength);
+
+    juce::int64 lastChange = -1;
+    float targetBeforeChange = -1.0f;
+    float previousTarget = -1.0f;
+
+    forEachSegment(from, timelineSample, [&] (juce::int64 segmentStart, juce::int64, const GateSegment& segment)
+    {
+        const float target = segment.open ? 1.0f : 0.0f;
+        if (previousTarget >= 0.0f && target != previousTarget)
+        {
+            lastChange = segmentStart;
+            targetBeforeChange = previousTarget;
+        }
+        previousTarget = target;
+    });
+
+    EnvelopeState state;
+    state.position = timelineSample;
+    state.smoother.reset(sampleRate, 0.0);
+
+    if (lastChange < 0 && from > 0)
+    {
+        state.smoother.setCurrentAndTargetValue(previousTarget);
+        state.previousTargetGain = previousTarget;
+        return state;
+    }
+
+    const auto replayStart = lastChange >= 0 ? lastChange : (juce::int64) 0;
+    if (lastChange >= 0)
+    {
+        state.smoother.setCurrentAndTargetValue(targetBeforeChange);
+        state.previousTargetGain = targetBeforeChange;
+    }
+
+    forEachSegment(replayStart, timelineSample, [&] (juce::int64 segmentStart, juce::int64 segmentEnd, const GateSegment& segment)
+    {
+        setGateTarget(state, segment.open ? 1.0f : 0.0f);
+        advance(state, segmentEnd - segmentStart);
+    });
+
+    return state;
+}
+
+void OfflineGateRenderer::setGateTarget(EnvelopeState& state, float targetGain) const
+{
+    // Same ramps as RhythmicGateAudioProcessor::setGateTarget
+    if (targetGain == state.previousTargetGain)
+        return;
+
+    if (targetGain > state.previousTargetGain)
+        state.smoother.reset(sampleRate, attackMs / 1000.0); // Attack
+    else
+        state.smoother.reset(sampleRate, releaseMs / 1000.0); // Release
+
+    state.smoother.setTargetValue(targetGain);
+    state.previousTargetGain = targetGain;
+}
+
+void OfflineGateRenderer::advance(EnvelopeState& state, juce::int64 numSamples)
+{
+    // Sample by sample, as render() does, so that the ramp values match exactly
+    for (; numSamples > 0 && state.smoother.isSmoothing(); --numSamples)
+        state.smoother.getNextValue();
+}
+
+template <typename Callback>
+void OfflineGateRenderer::forEachSegment(juce::int64 start, juce::int64 end, Callback&& callback) const
+{
+    GateScheduler scheduler;
+    scheduler.setTiming(stepDurationInPpq, numSteps);
+
+    auto stepLookup = [this] (int step)
+    {
+        return std::make_pair(steps.isOn(step), steps.duration[step]);
+    };
+
+    for (auto position = start; position < end;)
+    {
+        const auto frameStart = position / frameLength * frameLength;
+        const double framePpq = startPpq + (double) frameStart * ppqPerSample;
+        const int frameEnd = (int) (juce::jmin(end, frameStart + frameLength) - frameStart);
+
+        for (int sample = (int) (position - frameStart); sample < frameEnd;)
+        {
+            const auto segment = scheduler.getSegment(framePpq, ppqPerSample, sample, frameEnd, stepLookup);
+            callback(frameStart + sample, frameStart + segment.endSample, segment);
+            sample = segment.endSample;
+        }
+
+        position = frameStart + frameEnd;
+    }
+}
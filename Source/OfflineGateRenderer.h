@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    OfflineGateRenderer.h
+    Created: 16 Oct 2026 6:05:33pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/** Renders the gate offline, as a function of the position on a timeline of
+    constant tempo. Any range of samples can be rendered on its own, and
+    ranges rendered separately join sample-exactly, so long files can be
+    split in chunks rendered concurrently.
+
+    The pattern, metric, step count and attack/release are a snapshot of the
+    processor's parameters, taken at construction.
+*/
+class OfflineGateRenderer
+{
+public:
+    OfflineGateRenderer(RhythmicGateAudioProcessor& processor, const juce::AudioChannelSet& channelSet,
+                        double sampleRate, double bpm, double startPpq = 0.0);
+
+    /** Applies the gate to the input, whose first sample is at timelineSample
+        on the timeline. mainOutput receives the Main output and, unless it has
+        no channels, auxOutput the Aux output. mainOutput may be the input.
+        Can be called from several threads at once.
+    */
+    void render(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& mainOutput,
+                juce::AudioBuffer<float>& auxOutput, juce::int64 timelineSample) const;
+
+    /** State of the gate envelope between two consecutive renders. */
+    struct EnvelopeState
+    {
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smoother;
+        float previousTargetGain = -1.0f;
+        juce::int64 position = -1; // Timeline sample the state is at, -1 when unknown
+    };
+
+    /** Same as render(), for the consecutive blocks of a stream: the envelope
+        is carried from one block to the next in state, instead of being found
+        again at the start of each block. Start with a default EnvelopeState.
+    */
+    void render(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& mainOutput,
+                juce::AudioBuffer<float>& auxOutput, juce::int64 timelineSample, EnvelopeState& state) const;
+
+    /** Same as render(), split in chunks rendered concurrently by the pool. */
+    void renderParallel(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& mainOutput,
+                        juce::AudioBuffer<float>& auxOutput, juce::int64 timelineSample,
+                        juce::ThreadPool& pool, int chunkSize = defaultChunkSize) const;
+
+    static constexpr int defaultChunkSize = 1 << 18;
+
+private:
+    //==============================================================================
+    // Positions are computed from the start of fixed frames of the timeline,
+    // so that they do not depend on where a render starts
+    static constexpr juce::int64 frameLength = 1 << 16;
+
+    // Longest run of samples rendered in one pass of the scratch buffers
+    static constexpr int maxRunLength = 4096;
+
+    EnvelopeState getEnvelopeStateAt(juce::int64 timelineSample) const;
+    void setGateTarget(EnvelopeState& state, float targetGain) const;
+    static void advance(EnvelopeState& state, juce::int64 numSamples);
+
+    template <typename Callback>
+    void forEachSegment(juce::int64 start, juce::int64 end, Callback&& callback) const;
+
+    StepTable<RhythmicGateAudioProcessor::NUM_STEPS> steps;
+    std::vector<int> panGroupOfChannel;
+
+    double sampleRate;
+    double ppqPerSample;
+    double startPpq;
+    double stepDurationInPpq;
+    int numSteps;
+    float attackMs;
+    float releaseMs;
+
+    JUCE_DECLARE_NON_COPYABLE(OfflineGateRenderer)
+};
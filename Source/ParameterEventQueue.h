@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    ParameterEventQueue.h
+    Created: 16 Oct 2026 4:52:18pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** A parameter change at a sample offset of the block being processed. */
+struct ParameterEvent
+{
+    int sampleOffset;   // Sample of the block from which the new value applies
+    int parameterIndex; // Index of the parameter in the processor
+    float value;        // New value, in the parameter's own range
+};
+
+//==============================================================================
+/** Fixed-capacity list of the parameter changes of one block, kept sorted by
+    sample offset. Changes at the same offset keep the order they were added
+    in. Nothing is allocated after construction, so it can be filled and read
+    on the audio thread.
+*/
+template <int Capacity>
+class ParameterEventQueue
+{
+public:
+    /** Adds an event. Returns false, and drops the event, if the queue is full. */
+    bool add(const ParameterEvent& event) noexcept
+    {
+        if (numEvents == Capacity)
+            return false;
+
+        // Events mostly arrive in order, so the insertion point is usually the end
+        int index = numEvents;
+        while (index > 0 && events[(size_t) (index - 1)].sampleOffset > event.sampleOffset)
+        {
+            events[(size_t) index] = events[(size_t) (index - 1)];
+            --index;
+        }
+
+        events[(size_t) index] = event;
+        ++numEvents;
+        return true;
+    }
+
+    void clear() noexcept                                   { numEvents = 0; }
+    int size() const noexcept                               { return numEvents; }
+    bool isEmpty() const noexcept                           { return numEvents == 0; }
+    const ParameterEvent& operator[](int index) const noexcept { return events[(size_t) index]; }
+
+private:
+    std::array<ParameterEvent, Capacity> events {};
+    int numEvents = 0;
+};
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    PlayheadRecord.h
+    Created: 16 Oct 2026 11:31:52pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** The playhead of the last processed block, published by the audio thread
+    for the editor.
+
+    The record is a sequence lock: the audio thread writes it without waiting,
+    and a reader retries in the rare case where it overlaps a write, so it
+    always gets the fields of a single block.
+
+    With the tempo and the time at which the block was processed, a reader
+    can extrapolate the position at any later time, within the block and the
+    next one, however large the blocks are.
+*/
+class PlayheadRecord
+{
+public:
+    struct State
+    {
+        int step = -1;                  // Active step, -1 when the gate is not running
+        double ppq = 0.0;               // Position at the start of the block
+        double bpm = 120.0;
+        double stepDurationInPpq = 0.25;
+        int numSteps = 16;
+        juce::int64 samplePosition = 0; // Samples processed before the block, since the start
+        int numSamples = 0;             // Samples in the block
+        double sampleRate = 44100.0;
+        juce::int64 timeTicks = 0;      // High resolution ticks at the start of the block
+        bool isPlaying = false;         // Host transport state
+
+        /** Returns the position in the sequence at the given time, in steps
+            (3.5 is the middle of the fourth step), or -1 when the gate is not
+            running. The position is not extrapolated beyond the next block.
+        */
+        double getStepPositionAt(juce::int64 ticks) const noexcept
+        {
+            if (step < 0 || ! (stepDurationInPpq > 0.0) || numSteps <= 0 || ! (sampleRate > 0.0))
+                return -1.0;
+
+            const auto maxSeconds = 2.0 * numSamples / sampleRate;
+            const auto seconds = juce::jlimit(0.0, maxSeconds, juce::Time::highResolutionTicksToSeconds(ticks - timeTicks));
+            const auto position = std::fmod((ppq + seconds * bpm / 60.0) / stepDurationInPpq, (double) numSteps);
+
+            return position < 0.0 ? position + numSteps : position;
+        }
+    };
+
+    /** Publishes the state of a block, from the audio thread only. */
+    void publish(const State& state) noexcept
+    {
+        const auto currentSequence = sequence.load(std::memory_order_relaxed);
+        sequence.store(currentSequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        step.store(state.step, std::memory_order_relaxed);
+        ppq.store(state.ppq, std::memory_order_relaxed);
+        bpm.store(state.bpm, std::memory_order_relaxed);
+        stepDurationInPpq.store(state.stepDurationInPpq, std::memory_order_relaxed);
+        numSteps.store(state.numSteps, std::memory_order_relaxed);
+        samplePosition.store(state.samplePosition, std::memory_order_relaxed);
+        numSamples.store(state.numSamples, std::memory_order_relaxed);
+        sampleRate.store(state.sampleRate, std::memory_order_relaxed);
+        timeTicks.store(state.timeTicks, std::memory_order_relaxed);
+        isPlaying.store(state.isPlaying, std::memory_order_relaxed);
+
+        sequence.store(currentSequence + 2, std::memory_order_release);
+    }
+
+    /** Returns the last published state, from any thread. */
+    State read() const noexcept
+    {
+        for (;;)
+        {
+            const auto sequenceBefore = sequence.load(std::memory_order_acquire);
+
+            State state;
+            state.step = step.load(std::memory_order_relaxed);
+            state.ppq = ppq.load(std::memory_order_relaxed);
+            state.bpm = bpm.load(std::memory_order_relaxed);
+            state.stepDurationInPpq = stepDurationInPpq.load(std::memory_order_relaxed);
+            state.numSteps = numSteps.load(std::memory_order_relaxed);
+            state.samplePosition = samplePosition.load(std::memory_order_relaxed);
+            state.numSamples = numSamples.load(std::memory_order_relaxed);
+            state.sampleRate = sampleRate.load(std::memory_order_relaxed);
+            state.timeTicks = timeTicks.load(std::memory_order_relaxed);
+            state.isPlaying = isPlaying.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // An odd or changed sequence means a write was in progress
+            if ((sequenceBefore & 1) == 0 && sequence.load(std::memory_order_relaxed) == sequenceBefore)
+                return state;
+        }
+    }
+
+private:
+    std::atomic<juce::uint32> sequence { 0 };
+    std::atomic<int> step { -1 };
+    std::atomic<double> ppq { 0.0 };
+    std::atomic<double> bpm { 120.0 };
+    std::atomic<double> stepDurationInPpq { 0.25 };
+    std::atomic<int> numSteps { 16 };
+    std::atomic<juce::int64> samplePosition { 0 };
+    std::atomic<int> numSamples { 0 };
+    std::atomic<double> sampleRate { 44100.0 };
+    std::atomic<juce::int64> timeTicks { 0 };
+    std::atomic<bool> isPlaying { false };
+};
@@ -17,7 +17,9 @@
 RhythmicGateAudioProcessorEditor::RhythmicGateAudioProcessorEditor (RhythmicGateAudioProcessor& p)
     : AudioProcessorEditor (&p), audioProcessor (p),
       attackKnob(p.apvts, "ATTACK", "Attack", juce::Colours::orangered.darker()),
-      releaseKnob(p.apvts, "RELEASE", "Release", juce::Colours::orangered.darker())
+      releaseKnob(p.apvts, "RELEASE", "Release", juce::Colours::orangered.darker()),
+      stepGrid(p),
+      scopeView(p.getScopeFeed())
 {
     // Global metric selector (reordered to match PluginProcessor.cpp)
     const auto& metrics = RhythmicGateAudioProcessor::getMetrics();
@@ -32,10 +34,10 @@ RhythmicGateAudioProcessorEditor::RhythmicGateAudioProcessorEditor (RhythmicGate
     // Steps selector
     for (int i = 2; i <= RhythmicGateAudioProcessor::NUM_STEPS; ++i)
         stepsSelector.addItem(juce::String(i), i);
-    stepsSelector.setSelectedId(16);
+    stepsSelector.setSelectedId(RhythmicGateAudioProcessor::NUM_STEPS);
     addAndMakeVisible(stepsSelector);
     stepsAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.apvts, "STEPS", stepsSelector);
-    stepsSelector.onChange = [this] { updateStepComponentVisibility(); };
+    stepsSelector.onChange = [this] { updateVisibleSteps(); };
 
     // Attack and Release Knobs
     addAndMakeVisible(attackKnob);
@@ -51,39 +53,38 @@ RhythmicGateAudioProcessorEditor::RhythmicGateAudioProcessorEditor (RhythmicGate
     linkAllButton.setLookAndFeel(&fxmeLookAndFeel);
     linkAllButton.setColour(juce::TextButton::buttonColourId, juce::Colours::green);
     linkAllButton.onClick = [this] {
-        for (int i = 0; i < RhythmicGateAudioProcessor::NUM_STEPS; ++i) {
-            if (auto* param = audioProcessor.apvts.getParameter(ParameterID::get(i, "LINK")))
-                param->setValueNotifyingHost(1.0f);
-        }
+        RhythmicGateAudioProcessor::PatternEdit edit(audioProcessor);
+        for (int i = 0; i < RhythmicGateAudioProcessor::NUM_STEPS; ++i)
+            edit.set(audioProcessor.getLinkParameter(i), 1.0f);
     };
 
     addAndMakeVisible(linkNoneButton);
     linkNoneButton.setLookAndFeel(&fxmeLookAndFeel);
     linkNoneButton.setColour(juce::TextButton::buttonColourId, juce::Colours::red);
     linkNoneButton.onClick = [this] {
-        for (int i = 0; i < RhythmicGateAudioProcessor::NUM_STEPS; ++i) {
-            if (auto* param = audioProcessor.apvts.getParameter(ParameterID::get(i, "LINK")))
-                param->setValueNotifyingHost(0.0f);
-        }
+        RhythmicGateAudioProcessor::PatternEdit edit(audioProcessor);
+        for (int i = 0; i < RhythmicGateAudioProcessor::NUM_STEPS; ++i)
+            edit.set(audioProcessor.getLinkParameter(i), 0.0f);
     };
 
     addAndMakeVisible(linkInvertButton);
     linkInvertButton.setLookAndFeel(&fxmeLookAndFeel);
     linkInvertButton.setColour(juce::TextButton::buttonColourId, juce::Colours::orange);
     linkInvertButton.onClick = [this] {
+        RhythmicGateAudioProcessor::PatternEdit edit(audioProcessor);
         for (int i = 0; i < RhythmicGateAudioProcessor::NUM_STEPS; ++i)
         {
-            if (auto* param = audioProcessor.apvts.getParameter(ParameterID::get(i, "LINK")))
-                param->setValueNotifyingHost(param->getValue() < 0.5f ? 1.0f : 0.0f);
+            auto* param = audioProcessor.getLinkParameter(i);
+            edit.set(param, param->getValue() < 0.5f ? 1.0f : 0.0f);
         }
     };
 
-    // --- Create and setup Step Components ---
-    for (int i = 0; i < RhythmicGateAudioProcessor::NUM_STEPS; ++i)
-    {
-        stepComponents[i] = std::make_unique<StepComponent>(audioProcessor.apvts, i, fxmeLookAndFeel);
-        addAndMakeVisible(*stepComponents[i]);
-    }
+    // --- Step grid: the per-step controls of all the steps ---
+    addAndMakeVisible(stepGrid);
+
+    // --- Scope of the gate envelope and the output level, over the grid ---
+    addAndMakeVisible(scopeView);
+    scopeView.clear();
 
     // --- Setup Row Labels ---
     auto setupLabel = [this] (juce::Label& label)
@@ -105,16 +106,33 @@ RhythmicGateAudioProcessorEditor::RhythmicGateAudioProcessorEditor (RhythmicGate
     // Add the randomization callback when the logo is clicked
     logo.onClick = [this] { randomizeParameters(); };
 
-    // Set initial visibility of step components
-    updateStepComponentVisibility();
+    loadLabel.setFont (juce::Font (juce::FontOptions (11.0f)));
+    loadLabel.setJustificationType (juce::Justification::centred);
+    loadLabel.setMinimumHorizontalScale (0.5f);
+    loadLabel.setColour (juce::Label::textColourId, juce::Colours::grey);
+    loadLabel.setTooltip ("DSP load over the last half second, in % of the real-time budget: p50/p99/max");
+    addAndMakeVisible (loadLabel);
+   #if RHYGA_ENABLE_TRACING
+    // Traced builds: a click on the load writes the trace events to the desktop
+    loadLabel.addMouseListener(this, false);
+   #endif
+    lastLoadSnapshot = audioProcessor.getLoadMeter().getSnapshot();
+    updateLoadLabel();
+    updatePlayhead();
+
+    // Set the initial visible steps and accents
+    updateVisibleSteps();
     updateStepAccents();
 
+    // The background covers the whole editor
+    setOpaque(true);
+
     setResizable(true, true);
-    setResizeLimits(600, 250, 1800, 600);
-    setSize (1024, 250);
+    setResizeLimits(600, 250 + scopeHeight, 1800, 600 + scopeHeight);
+    setSize (1024, 250 + scopeHeight);
 
-    // Start the timer to update the GUI at 30 Hz
-    startTimerHz(60);
+    // The playhead is followed on vblank; the timer only checks for changes
+    startTimerHz(idleTimerHz);
 }
 
 RhythmicGateAudioProcessorEditor::~RhythmicGateAudioProcessorEditor()
@@ -124,15 +142,20 @@ RhythmicGateAudioProcessorEditor::~RhythmicGateAudioProcessorEditor()
 //==============================================================================
 void RhythmicGateAudioProcessorEditor::paint (juce::Graphics& g)
 {
-    auto diagonale = (getLocalBounds().getTopLeft() - getLocalBounds().getBottomRight()).toFloat();
-    auto length = diagonale.getDistanceFromOrigin();
-    auto perpendicular = diagonale.rotatedAboutOrigin (juce::degreesToRadians (90.0f)) / length;
-    auto height = float (getWidth() * getHeight()) / length;
-    auto bluegreengrey = juce::Colour::fromFloatRGBA (0.15f, 0.15f, 0.25f, 1.0f);
-    juce::ColourGradient grad (bluegreengrey.darker().darker().darker(), perpendicular * height,
-                           bluegreengrey, perpendicular * -height, false);
-    g.setGradientFill(grad);
-    g.fillAll();
+    RHYGA_TRACE_SCOPE(TraceEvents::getMessageThreadTrack(), "editor paint");
+
+    background.draw(g, getLocalBounds(), [this] (juce::Graphics& layer)
+    {
+        auto diagonale = (getLocalBounds().getTopLeft() - getLocalBounds().getBottomRight()).toFloat();
+        auto length = diagonale.getDistanceFromOrigin();
+        auto perpendicular = diagonale.rotatedAboutOrigin (juce::degreesToRadians (90.0f)) / length;
+        auto height = float (getWidth() * getHeight()) / length;
+        auto bluegreengrey = juce::Colour::fromFloatRGBA (0.15f, 0.15f, 0.25f, 1.0f);
+        juce::ColourGradient grad (bluegreengrey.darker().darker().darker(), perpendicular * height,
+                               bluegreengrey, perpendicular * -height, false);
+        layer.setGradientFill(grad);
+        layer.fillAll();
+    });
 }
 
 void RhythmicGateAudioProcessorEditor::resized()
@@ -142,12 +165,6 @@ void RhythmicGateAudioProcessorEditor::resized()
     juce::FlexBox mainLayout;
     mainLayout.flexDirection = juce::FlexBox::Direction::row;
 
-    // Sequencer row
-    juce::FlexBox sequencerRow;
-    sequencerRow.alignItems = juce::FlexBox::AlignItems::stretch;
-    for (auto& step : stepComponents)
-        sequencerRow.items.add(juce::FlexItem(*step).withFlex(1.0f));
-
     // Horizontal box for the link control buttons, now on the right side
     juce::FlexBox linkButtonsBox;
     linkButtonsBox.flexDirection = juce::FlexBox::Direction::row;
@@ -164,6 +181,7 @@ void RhythmicGateAudioProcessorEditor::resized()
     juce::FlexBox leftPanel;
     leftPanel.flexDirection = juce::FlexBox::Direction::column;
     leftPanel.items.add(juce::FlexItem(logo).withFlex(1.f));
+    leftPanel.items.add(juce::FlexItem(loadLabel).withHeight(14.f));
     leftPanel.items.add(juce::FlexItem(metricSelector).withFlex(.25f).withMargin(juce::FlexItem::Margin(5.f, 2.f, 5.f, 2.f)));
     leftPanel.items.add(juce::FlexItem(stepsSelector).withFlex(.25f).withMargin(juce::FlexItem::Margin(2.f, 2.f, 5.f, 2.f)));
     leftPanel.items.add(juce::FlexItem(arBox).withFlex(1.1f).withMargin(juce::FlexItem::Margin(5.0f, 2, 2, 2)));
@@ -181,43 +199,128 @@ void RhythmicGateAudioProcessorEditor::resized()
 
     // Add panels and sequencer to the main layout
     mainLayout.items.add(juce::FlexItem(leftPanel).withFlex(2.f).withMargin(juce::FlexItem::Margin(0.f, 5.f, 0.f, 0.f)));
-    mainLayout.items.add(juce::FlexItem(sequencerRow).withFlex(16.0f));
+    mainLayout.items.add(juce::FlexItem(stepGrid).withFlex(16.0f));
     mainLayout.items.add(juce::FlexItem(labelPanel).withFlex(1.2f));
 
-    mainLayout.performLayout(bounds.reduced(10));
+    bounds.reduce(10, 10);
+    const auto scopeStrip = bounds.removeFromBottom(scopeHeight);
+    mainLayout.performLayout(bounds);
+    scopeView.setBounds(stepGrid.getX(), scopeStrip.getY() + 5, stepGrid.getWidth(), scopeHeight - 5);
 }
 
 void RhythmicGateAudioProcessorEditor::timerCallback()
 {
-    int currentActiveStep = audioProcessor.activeStep.load();
+    RHYGA_TRACE_SCOPE(TraceEvents::getMessageThreadTrack(), "editor timerCallback");
 
-    if (currentActiveStep != lastActiveStep)
+    if (! isShowing())
     {
-        // Deactivate the old step
-        if (lastActiveStep >= 0 && lastActiveStep < stepComponents.size())
-            stepComponents[lastActiveStep]->setActive(false);
+        vblankAttachment.reset();
+        return;
+    }
 
-        // Activate the new step
-        if (currentActiveStep >= 0 && currentActiveStep < stepComponents.size())
-            stepComponents[currentActiveStep]->setActive(true);
+    stepGrid.refresh();
 
-        lastActiveStep = currentActiveStep;
+    // The load is refreshed twice per second
+    if (++numTicksSinceLoadUpdate >= idleTimerHz / 2)
+    {
+        numTicksSinceLoadUpdate = 0;
+        updateLoadLabel();
     }
+
+    if (vblankAttachment != nullptr)
+    {
+        // No block processed lately: stop following the playhead, after a last update
+        if (! isPlayheadRunning)
+        {
+            vblankAttachment.reset();
+            refreshScope();
+        }
+
+        return;
+    }
+
+    updatePlayhead();
+
+    // Blocks processed again: follow the playhead on each frame
+    if (isPlayheadRunning)
+        vblankAttachment = std::make_unique<juce::VBlankAttachment>(this, [this]
+        {
+            updatePlayhead();
+            stepGrid.refresh();
+
+            // The scope scrolls at half the frame rate, which is smooth enough
+            if (++numFramesSinceScopeRefresh >= 2)
+            {
+                numFramesSinceScopeRefresh = 0;
+                refreshScope();
+            }
+        });
 }
 
-void RhythmicGateAudioProcessorEditor::updateStepComponentVisibility()
+void RhythmicGateAudioProcessorEditor::updatePlayhead()
 {
-    int numSteps = stepsSelector.getSelectedId();
+    const auto playhead = audioProcessor.getPlayheadState();
 
-    if (numSteps != lastNumSteps)
+    const auto nowMs = juce::Time::getMillisecondCounter();
+    if (playhead.samplePosition != lastPlayheadSamplePosition)
     {
-        for (int i = 0; i < RhythmicGateAudioProcessor::NUM_STEPS; ++i)
-        {
-            const bool isVisible = (i < numSteps);
-            stepComponents[i]->setVisible(isVisible);
-        }
-        lastNumSteps = numSteps;
+        lastPlayheadSamplePosition = playhead.samplePosition;
+        lastPlayheadAdvanceMs = nowMs;
     }
+
+    // The transport state does not count: stopped, the gate runs on and the
+    // cursor must follow the internal position it gates on
+    isPlayheadRunning = playhead.step >= 0 && nowMs - lastPlayheadAdvanceMs <= idleTimeoutMs;
+
+    // Extrapolated from the last block to the time of the frame, so that the
+    // cursor moves smoothly whatever the block size; idle, it stays where the
+    // last block left it
+    const auto ticks = isPlayheadRunning ? juce::Time::getHighResolutionTicks() : playhead.timeTicks;
+    stepGrid.setPlayheadPosition(playhead.getStepPositionAt(ticks));
+}
+
+void RhythmicGateAudioProcessorEditor::refreshScope()
+{
+    // The scope shows one pass of the sequence
+    const auto playhead = audioProcessor.getPlayheadState();
+    const auto sequenceSeconds = playhead.numSteps * playhead.stepDurationInPpq * 60.0 / juce::jmax(1.0, playhead.bpm);
+    scopeView.refresh(juce::jlimit(0.5, 20.0, sequenceSeconds));
+}
+
+#if RHYGA_ENABLE_TRACING
+void RhythmicGateAudioProcessorEditor::mouseDown(const juce::MouseEvent& event)
+{
+    if (event.eventComponent != &loadLabel)
+        return;
+
+    const auto file = juce::File::getSpecialLocation(juce::File::userDesktopDirectory).getNonexistentChildFile("RhyGa-trace", ".json");
+    loadLabel.setText(TraceEvents::writeChromeTrace(file) ? "Trace saved" : "Trace failed", juce::dontSendNotification);
+}
+#endif
+
+void RhythmicGateAudioProcessorEditor::updateLoadLabel()
+{
+    const auto snapshot = audioProcessor.getLoadMeter().getSnapshot();
+    const auto stats = ProcessLoadMeter::getStats(snapshot, lastLoadSnapshot);
+    lastLoadSnapshot = snapshot;
+
+    if (stats.numBlocks == 0)
+    {
+        loadLabel.setText ("DSP -", juce::dontSendNotification);
+        return;
+    }
+
+    auto format = [] (float load) { return juce::String (load, load < 10.0f ? 1 : 0); };
+    loadLabel.setText ("DSP " + format (stats.p50Load) + "/" + format (stats.p99Load) + "/" + format (stats.maxLoad) + "%",
+                       juce::dontSendNotification);
+
+    // A block that took longer than its duration is an overload
+    loadLabel.setColour (juce::Label::textColourId, stats.maxLoad >= 100.0f ? juce::Colours::red : juce::Colours::grey);
+}
+
+void RhythmicGateAudioProcessorEditor::updateVisibleSteps()
+{
+    stepGrid.setNumVisibleSteps(stepsSelector.getSelectedId());
 }
 
 void RhythmicGateAudioProcessorEditor::updateStepAccents()
@@ -229,48 +332,17 @@ void RhythmicGateAudioProcessorEditor::updateStepAccents()
     if (selectedIndex >= 0 && selectedIndex < metrics.size())
         isTernary = metrics[selectedIndex].isTriplet;
 
-    for (int i = 0; i < RhythmicGateAudioProcessor::NUM_STEPS; ++i)
-    {
-        bool shouldBeAccented = false;
-        if (isTernary)
-        {
-            // Accent every 3rd step for triplet feels
-            if (i % 3 == 0)
-                shouldBeAccented = true;
-        }
-        else
-        {
-            // Accent every 4th step for binary feels (downbeats)
-            if (i % 4 == 0)
-                shouldBeAccented = true;
-        }
-        stepComponents[i]->setAccented(shouldBeAccented);
-    }
+    // Accent every 3rd step for triplet feels, every 4th step for binary feels (downbeats)
+    stepGrid.setAccentPeriod(isTernary ? 3 : 4);
 }
 
 void RhythmicGateAudioProcessorEditor::randomizeParameters()
 {
     juce::Random random;
 
-    // We iterate through all parameters in the APVTS
-    for (auto* param : audioProcessor.getParameters())
-    {
-        // We only want to randomize per-step controls, not global ones like STEPS, ATTACK, or RELEASE.
-        // We also exclude the LINK parameters
-        // To get the parameter ID, we must safely cast the base AudioProcessorParameter
-        // to the RangedAudioParameter that it actually is.
-        if (auto* rangedParam = dynamic_cast<juce::RangedAudioParameter*>(param))
-        {
-            const auto& paramID = rangedParam->getParameterID();
-
-            if (!paramID.startsWith("METRIC") &&
-                !paramID.startsWith("ATTACK") &&
-                !paramID.startsWith("RELEASE") &&
-                !paramID.contains("LINK"))
-            {
-                // Set the parameter to a random value within its normalized range (0.0 to 1.0).
-                param->setValueNotifyingHost(random.nextFloat());
-            }
-        }
-    }
+    // The step count and the per-step controls are randomized, not the global
+    // controls (METRIC, ATTACK, RELEASE) nor the LINK parameters. Linked steps
+    // keep equal values. The whole pattern is applied as a single edit.
+    RhythmicGateAudioProcessor::PatternEdit edit(audioProcessor);
+    edit.randomize(random);
 }
@@ -12,7 +12,9 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "FxmeLogo.h"
-#include "StepComponent.h"
+#include "StepGrid.h"
+#include "ScopeView.h"
+#include "CachedLayer.h"
 
 //==============================================================================
 class RhythmicGateAudioProcessorEditor  : public juce::AudioProcessorEditor,
@@ -26,13 +28,20 @@ public:
     void paint (juce::Graphics&) override;
     void resized() override;
 
-    // Timer callback
+    // Idle check (10 Hz): parameter changes, DSP load, start of the playhead
     void timerCallback() override;
 
     // UI update function
-    void updateStepComponentVisibility();
+    void updateVisibleSteps();
     void updateStepAccents();
     void randomizeParameters();
+    void updateLoadLabel();
+    void updatePlayhead();
+    void refreshScope();
+
+   #if RHYGA_ENABLE_TRACING
+    void mouseDown(const juce::MouseEvent& event) override;
+   #endif
 
 private:
     RhythmicGateAudioProcessor& audioProcessor;
@@ -46,7 +55,8 @@ private:
     fxme::FxmeKnob attackKnob;
     fxme::FxmeKnob releaseKnob;
 
-    std::array<std::unique_ptr<StepComponent>, RhythmicGateAudioProcessor::NUM_STEPS> stepComponents;
+    StepGrid stepGrid;
+    ScopeView scopeView; // In a strip under the step grid
 
     // Link control buttons
     juce::TextButton linkAllButton    { "1" };
@@ -63,10 +73,29 @@ private:
 
     fxme::FxmeLookAndFeel fxmeLookAndFeel;
 
-    int lastActiveStep = -1;
-    int lastNumSteps = -1;
-
     FxmeLogo logo{"",false};
 
+    // Background gradient, rendered again only on resize or scale change
+    CachedLayer background;
+
+    // DSP load of the instance (p50/p99/max), next to the logo
+    juce::Label loadLabel;
+    ProcessLoadMeter::Snapshot lastLoadSnapshot;
+    int numTicksSinceLoadUpdate = 0;
+
+    // Follows the playhead on each vblank while the gate runs and the editor
+    // is showing; detached when idle, so that nothing is repainted. The gate
+    // keeps running on its internal position while the host transport is
+    // stopped, so only whether blocks are still processed counts.
+    std::unique_ptr<juce::VBlankAttachment> vblankAttachment;
+    juce::int64 lastPlayheadSamplePosition = -1;
+    juce::uint32 lastPlayheadAdvanceMs = 0;
+    bool isPlayheadRunning = false;
+    int numFramesSinceScopeRefresh = 0;
+
+    static constexpr int idleTimerHz = 10;
+    static constexpr int scopeHeight = 50; // Including the gap above the scope
+    static constexpr juce::uint32 idleTimeoutMs = 250; // Without any processed block
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RhythmicGateAudioProcessorEditor)
 };
\ No newline at end of file
@@ -68,27 +68,62 @@ RhythmicGateAudioProcessor::RhythmicGateAudioProcessor()
         auxSendParams[step]   = apvts.getRawParameterValue(ParameterID::get(step, "AUX_LVL"));
         panParams[step]       = apvts.getRawParameterValue(ParameterID::get(step, "PAN"));
         linkParams[step]      = apvts.getRawParameterValue(ParameterID::get(step, "LINK"));
+        linkParamObjects[step] = apvts.getParameter(ParameterID::get(step, "LINK"));
 
         // Cache parameter objects and initial values for linking logic
-        onOffParamObjects[step]    = apvts.getParameter(ParameterID::get(step, "ON"));
-        durationParamObjects[step] = apvts.getParameter(ParameterID::get(step, "DUR"));
-        levelParamObjects[step]    = apvts.getParameter(ParameterID::get(step, "LVL"));
-        auxSendParamObjects[step]  = apvts.getParameter(ParameterID::get(step, "AUX_LVL"));
-        panParamObjects[step]      = apvts.getParameter(ParameterID::get(step, "PAN"));
-
-        lastOnOffValues[step]    = onOffParamObjects[step]->getValue();
-        lastDurationValues[step] = durationParamObjects[step]->getValue();
-        lastLevelValues[step]    = levelParamObjects[step]->getValue();
-        lastAuxSendValues[step]  = auxSendParamObjects[step]->getValue();
-        lastPanValues[step]      = panParamObjects[step]->getValue();
+        linkedParamObjects[linkedOnOff][step]    = apvts.getParameter(ParameterID::get(step, "ON"));
+        linkedParamObjects[linkedDuration][step] = apvts.getParameter(ParameterID::get(step, "DUR"));
+        linkedParamObjects[linkedLevel][step]    = apvts.getParameter(ParameterID::get(step, "LVL"));
+        linkedParamObjects[linkedAuxSend][step]  = apvts.getParameter(ParameterID::get(step, "AUX_LVL"));
+        linkedParamObjects[linkedPan][step]      = apvts.getParameter(ParameterID::get(step, "PAN"));
+
+        for (int type = 0; type < numLinkedParameters; ++type)
+            lastLinkedValues[type][step] = linkedParamObjects[type][step]->getValue();
     }
+
+    randomizableParams.push_back(apvts.getParameter("STEPS"));
+    for (int step = 0; step < NUM_STEPS; ++step)
+        for (int type = 0; type < numLinkedParameters; ++type)
+            randomizableParams.push_back(linkedParamObjects[type][step]);
     previousTargetGain = -1.0f; // Initialize with a value that guarantees the first check will trigger
     internalPpq = 0.0;
+
+    // Listen to the per-step parameters to know which steps of the table must be
+    // refreshed and which changes must be propagated to the linked steps
+    slotOfParameterIndex.resize((size_t) getParameters().size());
+    for (int type = 0; type < numLinkedParameters; ++type)
+    {
+        for (int step = 0; step < NUM_STEPS; ++step)
+        {
+            auto* param = linkedParamObjects[type][step];
+            slotOfParameterIndex[(size_t) param->getParameterIndex()] = { step, type };
+            param->addListener(this);
+        }
+    }
+
+    // Parameter objects by index, to convert the values of queued changes
+    for (auto* param : getParameters())
+        parameterOfIndex.push_back(dynamic_cast<juce::RangedAudioParameter*>(param));
+
+    for (auto* paramID : stateGlobalIDs)
+        stateParams.push_back(apvts.getParameter(paramID));
+    for (int step = 0; step < NUM_STEPS; ++step)
+        for (auto* paramID : stateStepIDs)
+            stateParams.push_back(apvts.getParameter(ParameterID::get(step, paramID)));
+
+    attackParamIndex = apvts.getParameter("ATTACK")->getParameterIndex();
+    releaseParamIndex = apvts.getParameter("RELEASE")->getParameterIndex();
+    currentAttackMs = attackParam->load();
+    currentReleaseMs = releaseParam->load();
 }
 
 RhythmicGateAudioProcessor::~RhythmicGateAudioProcessor()
 {
-    // No need to remove the listener anymore
+    cancelPendingUpdate();
+
+    for (auto& params : linkedParamObjects)
+        for (auto* param : params)
+            param->removeListener(this);
 }
 
 //==============================================================================
@@ -100,9 +135,54 @@ const juce::String RhythmicGateAudioProcessor::getName() const
 void RhythmicGateAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
+    loadMeter.prepare(sampleRate);
+    scopeFeed.prepare(sampleRate);
     gateSmoother.reset(sampleRate, 0.0); // Reset smoother with sample rate
     previousTargetGain = -1.0f; // Also reset here in case of sample rate change
     internalPpq = 0.0;
+
+    // The Aux bus is optional: when the host disables it, nothing is computed for it
+    isAuxEnabled = getBusCount(false) > 1 && getBus(false, 1)->isEnabled();
+
+    // Scratch buffers for the envelope render pass, in the precision the host processes in
+    auto prepareRenderBuffers = [this, samplesPerBlock] (auto& buffers, bool isUsed)
+    {
+        const int size = isUsed ? samplesPerBlock : 0;
+        buffers.gate.setSize(1, size);
+        buffers.mainEnvelope.setSize(numPanGroups, size);
+        buffers.auxEnvelope.setSize(isAuxEnabled ? numPanGroups : 0, size);
+    };
+
+    prepareRenderBuffers(floatRenderBuffers, ! isUsingDoublePrecision());
+    prepareRenderBuffers(doubleRenderBuffers, isUsingDoublePrecision());
+
+    // A chunk may start in a scope frame and end in another
+    scopeLevels.resize((size_t) (samplesPerBlock / scopeFeed.getSamplesPerFrame() + 2));
+
+    // Adjacent runs never have the same state, so a chunk has at most one run per sample
+    envelopeRuns.clear();
+    envelopeRuns.reserve((size_t) samplesPerBlock);
+
+    // Map the channels of the main bus (the Aux bus has the same layout) to their pan group
+    const auto channelSet = getChannelLayoutOfBus(true, 0);
+    panGroupOfChannel.clear();
+    for (int channel = 0; channel < channelSet.size(); ++channel)
+        panGroupOfChannel.push_back(getPanGroup(channelSet.getTypeOfChannel(channel)));
+
+    if (channelSet == juce::AudioChannelSet::mono())
+        kernelLayout = KernelLayout::mono;
+    else if (channelSet == juce::AudioChannelSet::stereo())
+        kernelLayout = KernelLayout::stereo;
+    else
+        kernelLayout = KernelLayout::multichannel;
+
+    floatRenderKernel = getRenderKernel<float>(kernelLayout, isAuxEnabled);
+    doubleRenderKernel = getRenderKernel<double>(kernelLayout, isAuxEnabled);
+
+    // The timing is set again on the next block
+    timingNumSteps = -1;
+    gateScheduler.invalidate();
+    activeStepSpan = {};
 }
 
 void RhythmicGateAudioProcessor::releaseResources()
@@ -112,35 +192,56 @@ void RhythmicGateAudioProcessor::releaseResources()
 #ifndef JucePlugin_PreferredChannelConfigurations
 bool RhythmicGateAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 {
-    // We need 2 in, 4 out.
+    // Any layout (mono, stereo, surround, ambisonic, discrete), as long as
+    // the input, the Main output and the Aux output share it.
+    // The Aux output may be disabled.
     const auto& mainIn = layouts.getChannelSet(true, 0);
     const auto& mainOut = layouts.getChannelSet(false, 0);
     const auto& auxOut = layouts.getChannelSet(false, 1);
 
-    if (mainIn == juce::AudioChannelSet::disabled() || mainOut == juce::AudioChannelSet::disabled() || auxOut == juce::AudioChannelSet::disabled())
+    if (mainIn == juce::AudioChannelSet::disabled() || mainOut == juce::AudioChannelSet::disabled())
         return false;
 
-    return (mainIn == juce::AudioChannelSet::stereo() &&
-            mainOut == juce::AudioChannelSet::stereo() &&
-            auxOut == juce::AudioChannelSet::stereo());
+    return mainIn == mainOut && (auxOut == juce::AudioChannelSet::disabled() || auxOut == mainOut);
 }
 #endif
 
-void RhythmicGateAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+void RhythmicGateAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
+    RHYGA_TRACE_SCOPE(audioTraceTrack, "processBlock");
+    const ProcessLoadMeter::ScopedBlockTimer timer(loadMeter, buffer.getNumSamples());
+    process(buffer);
+}
+
+void RhythmicGateAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    RHYGA_TRACE_SCOPE(audioTraceTrack, "processBlock");
+    const ProcessLoadMeter::ScopedBlockTimer timer(loadMeter, buffer.getNumSamples());
+    process(buffer);
+}
 
-    // Clear any extra output channels to prevent garbage audio
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
+bool RhythmicGateAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template <typename SampleType>
+void RhythmicGateAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer)
+{
+    juce::ScopedNoDenormals noDenormals;
 
     // Get playhead from host
     auto* playHead = getPlayHead();
     if (playHead == nullptr)
     {
+        // Clear any extra output channels to prevent garbage audio (the render
+        // kernels write every channel of the Aux bus themselves)
+        for (auto i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
+            buffer.clear (i, 0, buffer.getNumSamples());
+
         // If no playhead, just pass audio through to main output
+        flushParameterEvents(0);
+        publishPlayhead({}, buffer.getNumSamples());
         auto* mainBus = getBus(false, 0);
         for(int ch = 0; ch < mainBus->getNumberOfChannels(); ++ch)
             buffer.copyFrom(ch, 0, buffer, ch, 0, buffer.getNumSamples());
@@ -151,15 +252,16 @@ void RhythmicGateAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     if (!optionalPositionInfo.hasValue())
     {
         // If no position info, mute all outputs
-        activeStep = -1; // Reset active step when not playing
+        flushParameterEvents(0);
+        activeStepSpan = {};
+        publishPlayhead({}, buffer.getNumSamples()); // No active step when not playing
         buffer.clear();
         return;
     }
 
     const auto& positionInfo = *optionalPositionInfo;
 
-    // Handle parameter linking before processing audio
-    updateLinkedParameters();
+    updateStepTable();
 
     // Calculate BPM (default to 120 if unavailable) and PPQ increment per sample
     auto bpmOpt = positionInfo.getBpm();
@@ -185,88 +287,667 @@ void RhythmicGateAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
     int numSteps = static_cast<int>(stepsParam->load());
 
-    float attackMs = attackParam->load();
-    float releaseMs = releaseParam->load();
+    // Automated values change at the offsets of their events instead
+    if (! isAttackAutomated)
+        currentAttackMs = attackParam->load();
+    if (! isReleaseAutomated)
+        currentReleaseMs = releaseParam->load();
 
     // --- Rhythmic Gate Logic ---
     int metricIndex = static_cast<int>(metricParam->load());
-    
-    const auto& metrics = getMetrics();
-    double stepDurationInPpq = (metricIndex >= 0 && metricIndex < metrics.size()) 
-                               ? metrics[metricIndex].duration 
-                               : 0.25; // Default fallback
-
-    double sequenceDurationInPpq = numSteps * stepDurationInPpq;
-
-    // Calculate active step for the GUI using the correct step duration
-    double sequencePpqForGui = fmod(currentBlockPpq, sequenceDurationInPpq);
-    activeStep = static_cast<int>(sequencePpqForGui / stepDurationInPpq);
-
-
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-    {
-        // Calculate precise position for this sample using the pre-calculated start PPQ
-        double currentPpq = currentBlockPpq + (sample * ppqPerSample);
-        
-        // Find our position within the 32-step sequence
-        double sequencePpq = fmod(currentPpq, sequenceDurationInPpq);
-        int currentStep = static_cast<int>(sequencePpq / stepDurationInPpq);
-
-        // Ensure step is within bounds
-        currentStep = juce::jlimit(0, numSteps - 1, currentStep);
-
-        // Calculate how far into the current step we are (0.0 to 1.0)
-        double stepProgress = fmod(sequencePpq, stepDurationInPpq) / stepDurationInPpq;
-        
-        // Get current step's parameters (now shared between channels)
-        bool isOn = onOffParams[currentStep]->load() > 0.5f;
-        float duration = durationParams[currentStep]->load();
-        float mainLevel = juce::Decibels::decibelsToGain(levelParams[currentStep]->load());
-        float auxLevel = juce::Decibels::decibelsToGain(auxSendParams[currentStep]->load());
-        float pan = panParams[currentStep]->load(); // -1 (L) to 1 (R)
-        
+
+    // The timing only changes with the metric or the step count, so small
+    // blocks do not pay for it
+    if (metricIndex != timingMetricIndex || numSteps != timingNumSteps)
+    {
+        const auto& metrics = getMetrics();
+        double stepDurationInPpq = (metricIndex >= 0 && metricIndex < metrics.size())
+                                   ? metrics[metricIndex].duration
+                                   : 0.25; // Default fallback
+
+        gateScheduler.setTiming(stepDurationInPpq, numSteps);
+        timingMetricIndex = metricIndex;
+        timingNumSteps = numSteps;
+        activeStepSpan = {};
+    }
+
+    RenderKernel<SampleType> renderKernel;
+    if constexpr (std::is_same_v<SampleType, double>)
+        renderKernel = doubleRenderKernel;
+    else
+        renderKernel = floatRenderKernel;
+
+    // Calculate active step for the GUI using the correct step duration,
+    // only when the block leaves the range of the current one
+    if (! activeStepSpan.contains(currentBlockPpq))
+    {
+        activeStepSpan = gateScheduler.getStepSpanAt(currentBlockPpq);
+    }
+
+    PlayheadRecord::State playhead;
+    playhead.step = activeStepSpan.step;
+    playhead.ppq = currentBlockPpq;
+    playhead.bpm = bpm;
+    playhead.stepDurationInPpq = gateScheduler.getStepDurationInPpq();
+    playhead.numSteps = gateScheduler.getNumSteps();
+    playhead.isPlaying = positionInfo.getIsPlaying();
+    publishPlayhead(playhead, buffer.getNumSamples());
+
+    const int numSamples = buffer.getNumSamples();
+    const int maxChunkSize = getRenderBuffers<SampleType>().gate.getNumSamples();
+    jassert(maxChunkSize > 0); // prepareToPlay must be called before processing, in the same precision
+
+    // Without scratch buffers nothing is rendered: the outputs, Aux included,
+    // must not keep what the host left in the buffer
+    if (maxChunkSize == 0)
+        buffer.clear();
+
+    // Render the envelopes into the scratch buffers, then apply them to the
+    // buses. The block is split in chunks at the queued parameter changes, and
+    // where it is larger than announced in prepareToPlay.
+    int nextEvent = 0;
+
+    for (int chunkStart = 0; chunkStart < numSamples && maxChunkSize > 0;)
+    {
+        while (nextEvent < parameterEvents.size() && parameterEvents[nextEvent].sampleOffset <= chunkStart)
+            applyParameterEvent(parameterEvents[nextEvent++]);
+
+        int chunkEnd = juce::jmin(numSamples, chunkStart + maxChunkSize);
+        if (nextEvent < parameterEvents.size())
+            chunkEnd = juce::jmin(chunkEnd, parameterEvents[nextEvent].sampleOffset);
+
+        (this->*renderKernel)(mainOutputBuffer, auxOutputBuffer, chunkStart, chunkEnd - chunkStart,
+                              currentBlockPpq + chunkStart * ppqPerSample, ppqPerSample, currentAttackMs, currentReleaseMs);
+        chunkStart = chunkEnd;
+    }
+
+    // Changes queued past the end of the block still apply
+    flushParameterEvents(nextEvent);
+}
+
+bool RhythmicGateAudioProcessor::queueParameterChange(int parameterIndex, float newNormalisedValue, int sampleOffset)
+{
+    if (! juce::isPositiveAndBelow(parameterIndex, (int) parameterOfIndex.size()) || parameterOfIndex[(size_t) parameterIndex] == nullptr)
+        return false;
+
+    const auto slot = slotOfParameterIndex[(size_t) parameterIndex];
+    const bool isSampleAccurate = slot.step >= 0 || parameterIndex == attackParamIndex || parameterIndex == releaseParamIndex;
+
+    // Other parameters apply from the start of the block, through their value
+    if (! isSampleAccurate)
+        return true;
+
+    const float value = parameterOfIndex[(size_t) parameterIndex]->convertFrom0to1(newNormalisedValue);
+    if (! parameterEvents.add({ juce::jmax(0, sampleOffset), parameterIndex, value }))
+        return false;
+
+    if (slot.step >= 0)
+        automatedSteps[(size_t) slot.type] |= juce::uint64(1) << slot.step;
+    else if (parameterIndex == attackParamIndex)
+        isAttackAutomated = true;
+    else
+        isReleaseAutomated = true;
+
+    return true;
+}
+
+void RhythmicGateAudioProcessor::applyParameterEvent(const ParameterEvent& event)
+{
+    if (event.parameterIndex == attackParamIndex)
+    {
+        currentAttackMs = event.value;
+    }
+    else if (event.parameterIndex == releaseParamIndex)
+    {
+        currentReleaseMs = event.value;
+    }
+    else
+    {
+        // The current table is only read by the audio thread, so it can be changed in place
+        const auto slot = slotOfParameterIndex[(size_t) event.parameterIndex];
+        setStepParameter(stepTables[(size_t) frontStepTable], slot.step, slot.type, event.value);
+        gateScheduler.invalidate();
+    }
+}
+
+void RhythmicGateAudioProcessor::flushParameterEvents(int firstEvent)
+{
+    for (int i = firstEvent; i < parameterEvents.size(); ++i)
+        applyParameterEvent(parameterEvents[i]);
+
+    parameterEvents.clear();
+    automatedSteps.fill(0);
+    isAttackAutomated = false;
+    isReleaseAutomated = false;
+}
+
+void RhythmicGateAudioProcessor::setStepParameter(StepTable<NUM_STEPS>& table, int step, int type, float value) noexcept
+{
+    switch (type)
+    {
+        case linkedOnOff:    table.setOnOff(step, value);    break;
+        case linkedDuration: table.setDuration(step, value); break;
+        case linkedLevel:    table.setLevel(step, value);    break;
+        case linkedAuxSend:  table.setAuxLevel(step, value); break;
+        case linkedPan:      table.setPan(step, value);      break;
+        default:             break;
+    }
+}
+
+template <typename SampleType>
+RhythmicGateAudioProcessor::RenderKernel<SampleType> RhythmicGateAudioProcessor::getRenderKernel(KernelLayout layout, bool withAux)
+{
+    switch (layout)
+    {
+        case KernelLayout::mono:
+            return withAux ? &RhythmicGateAudioProcessor::renderChunk<SampleType, KernelLayout::mono, true>
+                           : &RhythmicGateAudioProcessor::renderChunk<SampleType, KernelLayout::mono, false>;
+        case KernelLayout::stereo:
+            return withAux ? &RhythmicGateAudioProcessor::renderChunk<SampleType, KernelLayout::stereo, true>
+                           : &RhythmicGateAudioProcessor::renderChunk<SampleType, KernelLayout::stereo, false>;
+        case KernelLayout::multichannel:
+            break;
+    }
+
+    return withAux ? &RhythmicGateAudioProcessor::renderChunk<SampleType, KernelLayout::multichannel, true>
+                   : &RhythmicGateAudioProcessor::renderChunk<SampleType, KernelLayout::multichannel, false>;
+}
+
+template <typename SampleType, RhythmicGateAudioProcessor::KernelLayout Layout, bool WithAux>
+void RhythmicGateAudioProcessor::renderChunk(juce::AudioBuffer<SampleType>& mainOutputBuffer, juce::AudioBuffer<SampleType>& auxOutputBuffer,
+                                             int startSample, int numSamples, double chunkPpq, double ppqPerSample,
+                                             float attackMs, float releaseMs)
+{
+    // The scope is only fed while an editor shows it
+    const bool feedsScope = scopeFeed.isFeeding();
+
+    // Silent input: the outputs stay silent, only the envelope has to move on
+    if (isSilent(mainOutputBuffer, startSample, numSamples))
+    {
+        const float maxGain = advanceEnvelope(chunkPpq, ppqPerSample, numSamples, attackMs, releaseMs);
+
+        if constexpr (WithAux)
+            for (int channel = 0; channel < auxOutputBuffer.getNumChannels(); ++channel)
+                auxOutputBuffer.clear(channel, startSample, numSamples);
+
+        // The largest gain of the chunk, as feedScope would show, not where the
+        // envelope ends up (which under-reports a release)
+        if (feedsScope)
+            scopeFeed.add(maxGain, 0.0f, 0.0f, 0.0f, 0.0f, numSamples);
+        return;
+    }
+
+    renderEnvelopes<SampleType, Layout, WithAux>(chunkPpq, ppqPerSample, numSamples, attackMs, releaseMs);
+    applyEnvelopes<SampleType, Layout, WithAux>(mainOutputBuffer, auxOutputBuffer, startSample, numSamples, feedsScope);
+
+    if (feedsScope)
+        feedScope<SampleType>(numSamples);
+}
+
+template <typename SampleType>
+bool RhythmicGateAudioProcessor::isSilent(const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples) noexcept
+{
+    // Returns at the first non-zero sample, so this is almost free on actual audio
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        const auto* data = buffer.getReadPointer(channel, startSample);
+
+        for (int i = 0; i < numSamples; ++i)
+            if (data[i] != SampleType(0))
+                return false;
+    }
+
+    return true;
+}
+
+void RhythmicGateAudioProcessor::setGateTarget(float targetGain, float attackMs, float releaseMs)
+{
+    // Only update the smoother's target and ramp time when the target gain changes
+    if (targetGain == previousTargetGain)
+        return;
+
+    // Set ramp length based on whether we are opening (attack) or closing (release) the gate
+    if (targetGain > previousTargetGain)
+        gateSmoother.reset(currentSampleRate, attackMs / 1000.0); // Attack
+    else
+        gateSmoother.reset(currentSampleRate, releaseMs / 1000.0); // Release
+
+    gateSmoother.setTargetValue(targetGain);
+    previousTargetGain = targetGain;
+}
+
+void RhythmicGateAudioProcessor::addEnvelopeRun(int endSample, bool isClosed) noexcept
+{
+    if (! envelopeRuns.empty() && envelopeRuns.back().isClosed == isClosed)
+        envelopeRuns.back().endSample = endSample;
+    else
+        envelopeRuns.push_back({ endSample, isClosed });
+}
+
+float RhythmicGateAudioProcessor::advanceEnvelope(double blockPpq, double ppqPerSample, int numSamples, float attackMs, float releaseMs)
+{
+    auto stepLookup = [this] (int step)
+    {
+        return std::make_pair(stepTable->isOn(step), stepTable->duration[step]);
+    };
+
+    // Same segments and ramps as renderEnvelopes, without rendering them. The
+    // ramp of a segment is linear, so its largest value is at one of its ends
+    // (the start one being at most one ramp step above the first sample).
+    float maxGain = 0.0f;
+
+    for (int segmentStart = 0; segmentStart < numSamples;)
+    {
+        const auto segment = gateScheduler.getSegment(blockPpq, ppqPerSample, segmentStart, numSamples, stepLookup);
+        setGateTarget(segment.open ? 1.0f : 0.0f, attackMs, releaseMs);
+        maxGain = juce::jmax(maxGain, gateSmoother.getCurrentValue());
+        gateSmoother.skip(segment.endSample - segmentStart);
+        maxGain = juce::jmax(maxGain, gateSmoother.getCurrentValue());
+        segmentStart = segment.endSample;
+    }
+
+    return maxGain;
+}
+
+template <typename SampleType, RhythmicGateAudioProcessor::KernelLayout Layout, bool WithAux>
+void RhythmicGateAudioProcessor::renderEnvelopes(double blockPpq, double ppqPerSample, int numSamples, float attackMs, float releaseMs)
+{
+    RHYGA_TRACE_SCOPE(audioTraceTrack, "renderEnvelopes");
+
+    // Pan groups present in the layout: mono is unpanned, stereo only has
+    // left and right, other layouts may have all of them
+    constexpr int firstGroup = Layout == KernelLayout::mono   ? (int) unpannedGroup : (int) leftPanGroup;
+    constexpr int endGroup   = Layout == KernelLayout::stereo ? (int) unpannedGroup : (int) numPanGroups;
+
+    auto stepLookup = [this] (int step)
+    {
+        return std::make_pair(stepTable->isOn(step), stepTable->duration[step]);
+    };
+
+    auto& buffers = getRenderBuffers<SampleType>();
+    auto* gate = buffers.gate.getWritePointer(0);
+    envelopeRuns.clear();
+
+    // Render the chunk as a sequence of segments in which the step and the
+    // open/closed state of the gate are constant
+    for (int segmentStart = 0; segmentStart < numSamples;)
+    {
+        const auto segment = gateScheduler.getSegment(blockPpq, ppqPerSample, segmentStart, numSamples, stepLookup);
+
+        // Get the segment's step gains (shared between channels)
+        const float mainLevel = stepTable->mainGain[segment.step];
+        [[maybe_unused]] const float auxLevel = stepTable->auxGain[segment.step];
+
         // Determine target gain for the smoother
-        float targetGain = (isOn && stepProgress < duration) ? 1.0f : 0.0f;
+        setGateTarget(segment.open ? 1.0f : 0.0f, attackMs, releaseMs);
+
+        // Gate envelope: only the attack/release ramp needs the smoother sample by sample
+        int sample = segmentStart;
+        while (sample < segment.endSample && gateSmoother.isSmoothing())
+            gate[sample++] = gateSmoother.getNextValue();
+
+        // Once the gate has settled closed, the rest of the segment is cleared
+        // by applyEnvelopes and needs no envelope
+        const bool isSettledClosed = gateSmoother.getCurrentValue() == 0.0f;
+        const int envelopeEnd = isSettledClosed ? sample : segment.endSample;
+        const int envelopeLength = envelopeEnd - segmentStart;
+
+        if (sample < envelopeEnd)
+            juce::FloatVectorOperations::fill(gate + sample, (SampleType) gateSmoother.getCurrentValue(), envelopeEnd - sample);
+
+        if (envelopeLength > 0)
+            addEnvelopeRun(envelopeEnd, false);
+        if (envelopeEnd < segment.endSample)
+            addEnvelopeRun(segment.endSample, true);
+
+        // Fold the step's level and pan into the envelope of each pan group
+        // Note: Aux send is also panned. To keep it mono, use auxLevel alone for the aux envelopes.
+        for (int group = firstGroup; group < endGroup && envelopeLength > 0; ++group)
+        {
+            const float panGain = stepTable->panGains[(size_t) group][segment.step];
+            juce::FloatVectorOperations::multiply(buffers.mainEnvelope.getWritePointer(group, segmentStart),
+                                                  gate + segmentStart, (SampleType) (mainLevel * panGain), envelopeLength);
+            if constexpr (WithAux)
+                juce::FloatVectorOperations::multiply(buffers.auxEnvelope.getWritePointer(group, segmentStart),
+                                                      gate + segmentStart, (SampleType) (auxLevel * panGain), envelopeLength);
+        }
+
+        segmentStart = segment.endSample;
+    }
+}
+
+template <typename SampleType, RhythmicGateAudioProcessor::KernelLayout Layout, bool WithAux>
+void RhythmicGateAudioProcessor::applyEnvelopes(juce::AudioBuffer<SampleType>& mainOutputBuffer,
+                                                juce::AudioBuffer<SampleType>& auxOutputBuffer,
+                                                int startSample, int numSamples, bool measureLevels)
+{
+    // The runs cover the whole chunk
+    jassert(! envelopeRuns.empty() && envelopeRuns.back().endSample == numSamples);
+
+    const auto& buffers = getRenderBuffers<SampleType>();
+
+    const int numChannels = Layout == KernelLayout::mono   ? 1
+                          : Layout == KernelLayout::stereo ? 2
+                                                           : juce::jmin(mainOutputBuffer.getNumChannels(), (int) panGroupOfChannel.size());
 
-        // Only update the smoother's target and ramp time when the target gain changes
-        if (targetGain != previousTargetGain)
+    // The levels are measured on each piece of a run just gated, while it is
+    // still in the cache, split at the ends of the scope frames. The closed
+    // runs are silent and add nothing.
+    const int firstFrameLength = scopeFeed.getNumSamplesToFrameEnd();
+    const int samplesPerFrame = scopeFeed.getSamplesPerFrame();
+    const int numFrames = numSamples <= firstFrameLength ? 1 : 2 + (numSamples - firstFrameLength - 1) / samplesPerFrame;
+
+    if (measureLevels)
+    {
+        jassert(numFrames <= (int) scopeLevels.size());
+        std::fill_n(scopeLevels.begin(), numFrames, ScopeLevels {});
+    }
+
+    [[maybe_unused]] auto measureRun = [&] (const SampleType* main, const SampleType* aux, int runStart, int runEnd)
+    {
+        for (int start = runStart; start < runEnd;)
+        {
+            const int frame = start < firstFrameLength ? 0 : 1 + (start - firstFrameLength) / samplesPerFrame;
+            const int end = juce::jmin(runEnd, firstFrameLength + frame * samplesPerFrame);
+            auto& levels = scopeLevels[(size_t) frame];
+
+            addLevels(main + start, end - start, levels.mainPeak, levels.mainSquares);
+            if constexpr (WithAux)
+                addLevels(aux + start, end - start, levels.auxPeak, levels.auxSquares);
+
+            start = end;
+        }
+    };
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const int group = Layout == KernelLayout::mono   ? (int) unpannedGroup
+                        : Layout == KernelLayout::stereo ? channel
+                                                         : panGroupOfChannel[(size_t) channel];
+
+        auto* main = mainOutputBuffer.getWritePointer(channel, startSample);
+        [[maybe_unused]] auto* aux = WithAux ? auxOutputBuffer.getWritePointer(channel, startSample) : nullptr;
+
+        int runStart = 0;
+        for (const auto& run : envelopeRuns)
         {
-            // Set ramp length based on whether we are opening (attack) or closing (release) the gate
-            if (targetGain > previousTargetGain)
-                gateSmoother.reset(currentSampleRate, attackMs / 1000.0); // Attack
+            const int runLength = run.endSample - runStart;
+
+            if (run.isClosed)
+            {
+                if constexpr (WithAux)
+                    juce::FloatVectorOperations::clear(aux + runStart, runLength);
+                juce::FloatVectorOperations::clear(main + runStart, runLength);
+            }
             else
-                gateSmoother.reset(currentSampleRate, releaseMs / 1000.0); // Release
+            {
+                // The main output shares its channels with the input, so write the aux first
+                if constexpr (WithAux)
+                    juce::FloatVectorOperations::multiply(aux + runStart, main + runStart,
+                                                          buffers.auxEnvelope.getReadPointer(group, runStart), runLength);
+                juce::FloatVectorOperations::multiply(main + runStart, buffers.mainEnvelope.getReadPointer(group, runStart), runLength);
+
+                if (measureLevels)
+                    measureRun(main, aux, runStart, run.endSample);
+            }
 
-            gateSmoother.setTargetValue(targetGain);
-            previousTargetGain = targetGain;
+            runStart = run.endSample;
         }
+    }
+
+    if (measureLevels && numChannels > 1)
+    {
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            scopeLevels[(size_t) frame].mainSquares /= (float) numChannels;
+            scopeLevels[(size_t) frame].auxSquares /= (float) numChannels;
+        }
+    }
+}
+
+template <typename SampleType>
+void RhythmicGateAudioProcessor::addLevels(const SampleType* data, int numSamples, float& peak, float& sumOfSquares) noexcept
+{
+    const auto range = juce::FloatVectorOperations::findMinAndMax(data, numSamples);
+    peak = juce::jmax(peak, (float) -range.getStart(), (float) range.getEnd());
+
+    // Independent partial sums: without them, the sum would have to be
+    // computed in order, and would not be vectorised
+    constexpr int numLanes = 8;
+    SampleType laneSums[numLanes] {};
 
-        float gain = gateSmoother.getNextValue();
-        // Calculate pan gains using a constant-power pan law
-        float panLeft = std::sqrt(0.5f * (1.0f - pan));
-        float panRight = std::sqrt(0.5f * (1.0f + pan));
+    int i = 0;
+    for (; i + numLanes <= numSamples; i += numLanes)
+        for (int lane = 0; lane < numLanes; ++lane)
+            laneSums[lane] += data[i + lane] * data[i + lane];
 
-        for (int channel = 0; channel < totalNumInputChannels; ++channel)
+    for (; i < numSamples; ++i)
+        laneSums[0] += data[i] * data[i];
+
+    for (auto laneSum : laneSums)
+        sumOfSquares += (float) laneSum;
+}
+
+template <typename SampleType>
+void RhythmicGateAudioProcessor::feedScope(int numSamples)
+{
+    const auto* gate = getRenderBuffers<SampleType>().gate.getReadPointer(0);
+    auto run = envelopeRuns.cbegin();
+    int runStart = 0;
+
+    // One piece per scope frame, or part of one, as measured by applyEnvelopes
+    for (int pieceStart = 0, frame = 0; pieceStart < numSamples; ++frame)
+    {
+        const int pieceEnd = juce::jmin(numSamples, pieceStart + scopeFeed.getNumSamplesToFrameEnd());
+
+        // The gate is only rendered in the open runs, and zero in the others
+        float gateMax = 0.0f;
+        while (run != envelopeRuns.cend() && runStart < pieceEnd)
         {
-            float inputSample = buffer.getSample(channel, sample);
-            float panGain = (channel == 0) ? panLeft : panRight;
-            
-            // Write to output buffers
-            // Note: Aux send is also panned. To keep it mono, you could remove panGain from the auxOutputBuffer line.
-            mainOutputBuffer.setSample(channel, sample, inputSample * gain * mainLevel * panGain);
-            auxOutputBuffer.setSample(channel, sample, inputSample * gain * auxLevel * panGain);
+            const int start = juce::jmax(runStart, pieceStart);
+            const int end = juce::jmin(run->endSample, pieceEnd);
+            if (! run->isClosed && end > start)
+                gateMax = juce::jmax(gateMax, (float) juce::FloatVectorOperations::findMaximum(gate + start, end - start));
+
+            if (run->endSample > pieceEnd)
+                break;
+
+            runStart = run->endSample;
+            ++run;
         }
+
+        const auto& levels = scopeLevels[(size_t) frame];
+        scopeFeed.add(gateMax, levels.mainPeak, levels.mainSquares, levels.auxPeak, levels.auxSquares, pieceEnd - pieceStart);
+        pieceStart = pieceEnd;
     }
 }
 
-void RhythmicGateAudioProcessor::updateLinkedParameters()
+void RhythmicGateAudioProcessor::parameterValueChanged(int parameterIndex, float)
 {
-    // Helper lambda to handle linking for a specific parameter array
-    auto handleLinking = [this](std::array<juce::AudioProcessorParameter*, NUM_STEPS>& params,
-                                std::array<float, NUM_STEPS>& lastValues)
+    if (! juce::isPositiveAndBelow(parameterIndex, (int) slotOfParameterIndex.size()))
+        return;
+
+    const auto slot = slotOfParameterIndex[(size_t) parameterIndex];
+    if (slot.step < 0)
+        return;
+
+    const auto stepBit = juce::uint64(1) << slot.step;
+    dirtySteps.fetch_or(stepBit);
+    linkDirtySteps[(size_t) slot.type].fetch_or(stepBit);
+
+    // Changes made on the message thread (e.g. from the editor) are propagated
+    // right away, the others (e.g. host automation) on the next message loop
+    // iteration; the update is only posted once until it is handled. The
+    // thread is checked first: the other flags belong to the message thread.
+    if (! juce::MessageManager::existsAndIsCurrentThread())
+        triggerAsyncUpdate();
+    else if (! isPropagatingLinks && patternEditDepth == 0 && ! isRestoringState())
+        propagateLinkedParameters();
+}
+
+void RhythmicGateAudioProcessor::updateStepTable()
+{
+    // Cheap test first: most blocks have nothing to update
+    if (dirtySteps.load(std::memory_order_relaxed) == 0)
+        return;
+
+    const auto sequence = patternEditSequence.load();
+    const auto restoreSequence = stateRestoreSequence.load();
+    if (((sequence | restoreSequence) & 1) != 0)
+        return; // Wait for the end of the pattern edit or state restore
+
+    const auto mask = dirtySteps.exchange(0);
+    if (mask == 0)
+        return;
+
+    auto& backTable = stepTables[(size_t) (1 - frontStepTable)];
+    backTable = *stepTable;
+
+    // Per-step parameter values, in LinkedParameter order
+    const std::array<std::atomic<float>*, NUM_STEPS>* values[numLinkedParameters]
+        { &onOffParams, &durationParams, &levelParams, &auxSendParams, &panParams };
+
+    for (int step = 0; step < NUM_STEPS; ++step)
+    {
+        const auto stepBit = juce::uint64(1) << step;
+        if ((mask & stepBit) == 0)
+            continue;
+
+        // Values automated in this block are set at the offsets of their events
+        for (int type = 0; type < numLinkedParameters; ++type)
+            if ((automatedSteps[(size_t) type] & stepBit) == 0)
+                setStepParameter(backTable, step, type, (*values[type])[(size_t) step]->load());
+    }
+
+    // A pattern edit or state restore began while reading the parameters: the
+    // back table may hold part of it, so keep the current one and retry on the
+    // next block
+    if (patternEditSequence.load() != sequence || stateRestoreSequence.load() != restoreSequence)
     {
+        dirtySteps.fetch_or(mask);
+        return;
+    }
+
+    frontStepTable = 1 - frontStepTable;
+    stepTable = &backTable;
+    gateScheduler.invalidate();
+}
+
+void RhythmicGateAudioProcessor::beginPatternEdit()
+{
+    jassert(juce::MessageManager::existsAndIsCurrentThread());
+
+    if (patternEditDepth++ == 0)
+        patternEditSequence.fetch_add(1);
+}
+
+void RhythmicGateAudioProcessor::endPatternEdit()
+{
+    jassert(patternEditDepth > 0);
+
+    if (--patternEditDepth > 0)
+        return;
+
+    // The edit sets every parameter explicitly: take the new values as the
+    // reference for the links instead of propagating them
+    for (int type = 0; type < numLinkedParameters; ++type)
+    {
+        linkDirtySteps[(size_t) type].store(0);
+        for (int step = 0; step < NUM_STEPS; ++step)
+            lastLinkedValues[type][step] = linkedParamObjects[type][step]->getValue();
+    }
+
+    patternEditSequence.fetch_add(1);
+}
+
+//==============================================================================
+RhythmicGateAudioProcessor::PatternEdit::PatternEdit(RhythmicGateAudioProcessor& processorToEdit)
+    : processor(processorToEdit)
+{
+    processor.beginPatternEdit();
+}
+
+RhythmicGateAudioProcessor::PatternEdit::~PatternEdit()
+{
+    for (auto* param : editedParameters)
+        param->endChangeGesture();
+
+    processor.endPatternEdit();
+}
+
+void RhythmicGateAudioProcessor::PatternEdit::set(juce::AudioProcessorParameter* param, float newNormalisedValue)
+{
+    if (param == nullptr)
+        return;
+
+    if (! editedParameters.contains(param))
+    {
+        editedParameters.add(param);
+        param->beginChangeGesture();
+    }
+
+    param->setValueNotifyingHost(newNormalisedValue);
+}
+
+void RhythmicGateAudioProcessor::PatternEdit::randomize(juce::Random& random)
+{
+    // One value per control for the whole link group
+    std::array<float, numLinkedParameters> linkedValues;
+    for (auto& value : linkedValues)
+        value = random.nextFloat();
+
+    for (auto* param : processor.randomizableParams)
+    {
+        const auto slot = processor.slotOfParameterIndex[(size_t) param->getParameterIndex()];
+        const bool isLinked = slot.step >= 0 && processor.linkParams[(size_t) slot.step]->load() > 0.5f;
+
+        set(param, isLinked ? linkedValues[(size_t) slot.type] : random.nextFloat());
+    }
+}
+
+void RhythmicGateAudioProcessor::handleAsyncUpdate()
+{
+    propagateLinkedParameters();
+}
+
+void RhythmicGateAudioProcessor::propagateLinkedParameters()
+{
+    jassert(juce::MessageManager::existsAndIsCurrentThread());
+    RHYGA_TRACE_SCOPE(TraceEvents::getMessageThreadTrack(), "propagateLinkedParameters");
+
+    // A restore running on another thread sets every parameter explicitly:
+    // nothing is propagated until it ends and resets the reference values
+    if (isRestoringState())
+        return;
+
+    if (linkValuesNeedReset.exchange(false))
+    {
+        for (int type = 0; type < numLinkedParameters; ++type)
+        {
+            linkDirtySteps[(size_t) type].store(0);
+            for (int step = 0; step < NUM_STEPS; ++step)
+                lastLinkedValues[type][step] = linkedParamObjects[type][step]->getValue();
+        }
+    }
+
+    // The notifications sent while propagating come back through
+    // parameterValueChanged; they only flag steps already up to date
+    const juce::ScopedValueSetter<bool> propagating(isPropagatingLinks, true);
+
+    for (int type = 0; type < numLinkedParameters; ++type)
+    {
+        auto& params = linkedParamObjects[type];
+        auto& lastValues = lastLinkedValues[type];
+
+        const auto mask = linkDirtySteps[(size_t) type].exchange(0);
+        if (mask == 0)
+            continue;
+
         for (int i = 0; i < NUM_STEPS; ++i)
         {
+            if ((mask & (juce::uint64(1) << i)) == 0)
+                continue;
+
             float currentValue = params[i]->getValue();
             if (std::abs(currentValue - lastValues[i]) > 0.0001f) // Check for change
             {
@@ -277,21 +958,15 @@ void RhythmicGateAudioProcessor::updateLinkedParameters()
                     {
                         if (i != j && linkParams[j]->load() > 0.5f)
                         {
-                            params[j]->setValueNotifyingHost(currentValue);
                             lastValues[j] = currentValue; // Update history to prevent feedback
+                            params[j]->setValueNotifyingHost(currentValue);
                         }
                     }
                 }
                 lastValues[i] = currentValue;
             }
         }
-    };
-
-    handleLinking(onOffParamObjects, lastOnOffValues);
-    handleLinking(durationParamObjects, lastDurationValues);
-    handleLinking(levelParamObjects, lastLevelValues);
-    handleLinking(auxSendParamObjects, lastAuxSendValues);
-    handleLinking(panParamObjects, lastPanValues);
+    }
 }
 
 //==============================================================================
@@ -303,17 +978,112 @@ juce::AudioProcessorEditor* RhythmicGateAudioProcessor::createEditor()
 //==============================================================================
 void RhythmicGateAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml (state.createXml());
-    copyXmlToBinary (*xml, destData);
+    // Compact binary state, read in one pass by readBinaryState
+    juce::MemoryOutputStream stream (destData, false);
+    stream.writeInt ((int) binaryStateMagic);
+    stream.writeInt (binaryStateVersion);
+    stream.writeCompressedInt ((int) stateGlobalIDs.size());
+    stream.writeCompressedInt (NUM_STEPS);
+    stream.writeCompressedInt ((int) stateStepIDs.size());
+
+    for (auto* param : stateParams)
+        stream.writeFloat (param->convertFrom0to1 (param->getValue()));
 }
 
 void RhythmicGateAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    // States saved by older versions are XML
+    std::vector<float> plainValues;
+    if (readBinaryState (data, sizeInBytes, plainValues) || readXmlState (data, sizeInBytes, plainValues))
+        restoreParameters (plainValues);
+}
+
+bool RhythmicGateAudioProcessor::readBinaryState(const void* data, int sizeInBytes, std::vector<float>& plainValues) const
+{
+    juce::MemoryInputStream stream(data, (size_t) juce::jmax(0, sizeInBytes), false);
+    if (sizeInBytes < 8 || (juce::uint32) stream.readInt() != binaryStateMagic || stream.readInt() != binaryStateVersion)
+        return false;
+
+    const int numGlobals = stream.readCompressedInt();
+    const int numSteps = stream.readCompressedInt();
+    const int numStepFields = stream.readCompressedInt();
+    const auto numValues = (juce::int64) numGlobals + (juce::int64) numSteps * numStepFields;
+    if (numGlobals < 0 || numSteps < 0 || numStepFields < 0 || stream.getNumBytesRemaining() < numValues * (juce::int64) sizeof(float))
+        return false;
+
+    plainValues.assign(parameterOfIndex.size(), std::numeric_limits<float>::quiet_NaN());
+
+    // Values of parameters this version does not have (e.g. steps beyond
+    // NUM_STEPS) are read and dropped
+    auto readValue = [&] (juce::RangedAudioParameter* param)
+    {
+        const float value = stream.readFloat();
+        if (param != nullptr && std::isfinite(value))
+            plainValues[(size_t) param->getParameterIndex()] = value;
+    };
+
+    const int numKnownGlobals = (int) stateGlobalIDs.size();
+    const int numKnownStepFields = (int) stateStepIDs.size();
+
+    for (int field = 0; field < numGlobals; ++field)
+        readValue(field < numKnownGlobals ? stateParams[(size_t) field] : nullptr);
+
+    for (int step = 0; step < numSteps; ++step)
+        for (int field = 0; field < numStepFields; ++field)
+            readValue(step < NUM_STEPS && field < numKnownStepFields
+                      ? stateParams[(size_t) (numKnownGlobals + step * numKnownStepFields + field)]
+                      : nullptr);
+
+    return true;
+}
+
+bool RhythmicGateAudioProcessor::readXmlState(const void* data, int sizeInBytes, std::vector<float>& plainValues) const
 {
     std::unique_ptr<juce::XmlElement> xmlState (getXmlFromBinary (data, sizeInBytes));
-    if (xmlState.get() != nullptr)
-        if (xmlState->hasTagName (apvts.state.getType()))
-            apvts.replaceState (juce::ValueTree::fromXml (*xmlState));
+    if (xmlState == nullptr || ! xmlState->hasTagName (apvts.state.getType()))
+        return false;
+
+    plainValues.assign(parameterOfIndex.size(), std::numeric_limits<float>::quiet_NaN());
+
+    // <PARAM id="..." value="..."/> children, as written by the AudioProcessorValueTreeState
+    for (auto* paramState : xmlState->getChildWithTagNameIterator("PARAM"))
+        if (auto* param = apvts.getParameter(paramState->getStringAttribute("id")))
+            if (paramState->hasAttribute("value"))
+                plainValues[(size_t) param->getParameterIndex()] = (float) paramState->getDoubleAttribute("value");
+
+    return true;
+}
+
+void RhythmicGateAudioProcessor::restoreParameters(const std::vector<float>& plainValues)
+{
+    // All parameters are set in one pass, like a pattern edit: the audio thread
+    // sees the whole state at once, no link is propagated, and the parameters
+    // that keep their value send no notification. Parameters missing from
+    // the state get their default value. The host may restore from any
+    // thread, so the restore has its own sequence instead of the pattern
+    // edit's, and the link reference values are reset on the message thread.
+    const juce::ScopedLock lock(stateRestoreLock);
+    stateRestoreSequence.fetch_add(1);
+
+    for (size_t index = 0; index < parameterOfIndex.size(); ++index)
+    {
+        auto* param = parameterOfIndex[index];
+        if (param == nullptr)
+            continue;
+
+        const float value = std::isnan(plainValues[index]) ? param->getDefaultValue()
+                                                           : param->convertTo0to1(plainValues[index]);
+        if (value != param->getValue())
+            param->setValueNotifyingHost(value);
+    }
+
+    linkValuesNeedReset.store(true);
+    stateRestoreSequence.fetch_add(1);
+
+    if (! juce::MessageManager::existsAndIsCurrentThread())
+        triggerAsyncUpdate();
+    else if (! isPropagatingLinks && patternEditDepth == 0)
+        propagateLinkedParameters();
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout RhythmicGateAudioProcessor::createParameterLayout()
@@ -329,7 +1099,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout RhythmicGateAudioProcessor::
         metricChoices,
         9)); // Default to 1/16 (index 9)
 
-    params.push_back(std::make_unique<juce::AudioParameterInt>("STEPS", "Steps", 2, 16, 16));
+    params.push_back(std::make_unique<juce::AudioParameterInt>("STEPS", "Steps", 2, NUM_STEPS, NUM_STEPS));
 
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         "ATTACK",
@@ -395,7 +1165,12 @@ bool RhythmicGateAudioProcessor::hasEditor() const { return true; }
 bool RhythmicGateAudioProcessor::acceptsMidi() const { return false; }
 bool RhythmicGateAudioProcessor::producesMidi() const { return false; }
 bool RhythmicGateAudioProcessor::isMidiEffect() const { return false; }
-double RhythmicGateAudioProcessor::getTailLengthSeconds() const { return 0.0; }
+double RhythmicGateAudioProcessor::getTailLengthSeconds() const
+{
+    // The output follows the input through the gate, which may still be in its release ramp
+    return releaseParam->load() / 1000.0;
+}
+
 int RhythmicGateAudioProcessor::getNumPrograms() { return 1; }
 int RhythmicGateAudioProcessor::getCurrentProgram() { return 0; }
 void RhythmicGateAudioProcessor::setCurrentProgram (int index) {}
@@ -11,6 +11,18 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "GateScheduler.h"
+#include "ParameterEventQueue.h"
+#include "PlayheadRecord.h"
+#include "ProcessLoadMeter.h"
+#include "ScopeFeed.h"
+#include "StepTable.h"
+#include "TraceEvents.h"
+
+// Number of steps of the sequencer, can be raised (up to 64) by the build
+#ifndef RHYGA_NUM_STEPS
+ #define RHYGA_NUM_STEPS 16
+#endif
 
 // A helper function to generate consistent parameter IDs
 namespace ParameterID
@@ -22,7 +34,9 @@ namespace ParameterID
 }
 
 //==============================================================================
-class RhythmicGateAudioProcessor  : public juce::AudioProcessor
+class RhythmicGateAudioProcessor  : public juce::AudioProcessor,
+                                    private juce::AudioProcessorParameter::Listener,
+                                    private juce::AsyncUpdater
 {
 public:
     struct Metric
@@ -46,6 +60,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -73,11 +89,68 @@ public:
     // Use APVTS for robust parameter management
     juce::AudioProcessorValueTreeState apvts;
 
-    // Public member to communicate the active step to the editor
-    std::atomic<int> activeStep { -1 };
+    static constexpr int NUM_STEPS = RHYGA_NUM_STEPS;
+    static_assert(NUM_STEPS >= 2 && NUM_STEPS <= 64, "The dirty step masks hold at most 64 steps");
+
+    //==============================================================================
+    /** Groups a bulk edit of the parameters (randomize, link buttons...).
+        Each edited parameter gets a single begin/end change gesture, no link
+        is propagated, and the audio thread only sees the pattern once the
+        edit is complete.
+    */
+    class PatternEdit
+    {
+    public:
+        explicit PatternEdit(RhythmicGateAudioProcessor& processorToEdit);
+        ~PatternEdit();
+
+        /** Sets a parameter, from a normalised value. */
+        void set(juce::AudioProcessorParameter* param, float newNormalisedValue);
+
+        /** Sets the step count and the per-step controls (not the links) to
+            random values. The linked steps get the same value for each
+            control, as if the links had been propagated.
+        */
+        void randomize(juce::Random& random);
+
+    private:
+        RhythmicGateAudioProcessor& processor;
+        juce::Array<juce::AudioProcessorParameter*> editedParameters;
+
+        JUCE_DECLARE_NON_COPYABLE(PatternEdit)
+    };
+
+    //==============================================================================
+    /** Queues a parameter change at a sample offset of the next block, for
+        sample-accurate automation. To be called on the audio thread, before
+        processBlock, by a host or wrapper that knows the offsets of its
+        automation points. The parameter itself is still set as usual: its
+        last queued value must be its value at the end of the block.
+        The per-step parameters, ATTACK and RELEASE change at their offset;
+        the other parameters apply from the start of the block.
+        Returns false if the queue of the block is full.
+
+        The JUCE plugin wrappers do not pass the offsets of the host
+        automation to the processor, so nothing in the plugin calls this:
+        host automation still applies at the start of each block. Only the
+        benchmark harness and custom wrappers use it.
+    */
+    bool queueParameterChange(int parameterIndex, float newNormalisedValue, int sampleOffset);
+
+    static constexpr int maxParameterEventsPerBlock = 1024;
+
+    // Parameter handles, resolved once at construction
+    juce::AudioProcessorParameter* getLinkParameter(int step) const { return linkParamObjects[(size_t) step]; }
+    const std::vector<juce::AudioProcessorParameter*>& getRandomizableParameters() const { return randomizableParams; }
 
-    static constexpr int NUM_STEPS = 16;
-    static constexpr int NUM_CHANNELS = 2; // L/R for inputs
+    // Time taken by processBlock, for the editor and test harnesses
+    const ProcessLoadMeter& getLoadMeter() const noexcept { return loadMeter; }
+
+    // Active step and position of the last processed block, for the editor
+    PlayheadRecord::State getPlayheadState() const noexcept { return playheadRecord.read(); }
+
+    // Decimated gate envelope and output levels, read by the editor
+    ScopeFeed& getScopeFeed() noexcept { return scopeFeed; }
 
 private:
     //==============================================================================
@@ -96,19 +169,27 @@ private:
     std::array<std::atomic<float>*, NUM_STEPS> panParams;
     std::array<std::atomic<float>*, NUM_STEPS> linkParams;
 
+    // Per-step parameters that follow the links, in the order used by the arrays below
+    enum LinkedParameter { linkedOnOff, linkedDuration, linkedLevel, linkedAuxSend, linkedPan, numLinkedParameters };
+
     // Parameter objects for linking logic (access to normalized values and notification)
-    std::array<juce::AudioProcessorParameter*, NUM_STEPS> onOffParamObjects;
-    std::array<juce::AudioProcessorParameter*, NUM_STEPS> durationParamObjects;
-    std::array<juce::AudioProcessorParameter*, NUM_STEPS> levelParamObjects;
-    std::array<juce::AudioProcessorParameter*, NUM_STEPS> auxSendParamObjects;
-    std::array<juce::AudioProcessorParameter*, NUM_STEPS> panParamObjects;
-
-    // Last normalized values to detect changes
-    std::array<float, NUM_STEPS> lastOnOffValues;
-    std::array<float, NUM_STEPS> lastDurationValues;
-    std::array<float, NUM_STEPS> lastLevelValues;
-    std::array<float, NUM_STEPS> lastAuxSendValues;
-    std::array<float, NUM_STEPS> lastPanValues;
+    std::array<std::array<juce::AudioProcessorParameter*, NUM_STEPS>, numLinkedParameters> linkedParamObjects;
+
+    std::array<juce::AudioProcessorParameter*, NUM_STEPS> linkParamObjects;
+
+    // Parameters changed when randomizing: the step count and all per-step controls except the links
+    std::vector<juce::AudioProcessorParameter*> randomizableParams;
+
+    // Last normalized values to detect changes (message thread only)
+    std::array<std::array<float, NUM_STEPS>, numLinkedParameters> lastLinkedValues;
+
+    // Steps whose linked parameters changed and still have to be propagated
+    std::array<std::atomic<juce::uint64>, numLinkedParameters> linkDirtySteps {};
+    bool isPropagatingLinks = false;
+
+    // Set by a state restore: the restored values must become the reference
+    // for the links, which only the message thread may do
+    std::atomic<bool> linkValuesNeedReset { false };
 
     double currentSampleRate = 44100.0;
     double internalPpq = 0.0;
@@ -117,7 +198,198 @@ private:
 
     float previousTargetGain = -1.0f;
 
-    void updateLinkedParameters();
+    GateScheduler gateScheduler;
+    ProcessLoadMeter loadMeter;
+    PlayheadRecord playheadRecord;
+    ScopeFeed scopeFeed;
+
+   #if RHYGA_ENABLE_TRACING
+    // Trace track of the audio callbacks, claimed with the processor so that
+    // tracing a block neither locks nor allocates
+    const int audioTraceTrack = TraceEvents::claimTrack("Audio callbacks");
+   #endif
+
+    // Levels of the outputs in each scope frame of a chunk (or part of one),
+    // measured by applyEnvelopes while a reader is attached to the feed.
+    // Sized in prepareToPlay for the longest chunk.
+    struct ScopeLevels
+    {
+        float mainPeak = 0.0f;
+        float mainSquares = 0.0f; // Averaged over the channels
+        float auxPeak = 0.0f;
+        float auxSquares = 0.0f;
+    };
+
+    std::vector<ScopeLevels> scopeLevels;
+    juce::int64 numSamplesProcessed = 0;
+
+    // Scratch buffers holding the gate envelope and the (gate x level x pan)
+    // envelopes of the Main and Aux buses, one channel per PanGroup: channels
+    // of the same group share an envelope, whatever the size of the bus.
+    // Only the buffers of the precision the host processes in are allocated.
+    template <typename SampleType>
+    struct RenderBuffers
+    {
+        juce::AudioBuffer<SampleType> gate;
+        juce::AudioBuffer<SampleType> mainEnvelope;
+        juce::AudioBuffer<SampleType> auxEnvelope;
+    };
+
+    RenderBuffers<float> floatRenderBuffers;
+    RenderBuffers<double> doubleRenderBuffers;
+
+    template <typename SampleType>
+    RenderBuffers<SampleType>& getRenderBuffers() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleRenderBuffers;
+        else
+            return floatRenderBuffers;
+    }
+
+    // Runs of the chunk in which the envelopes are applied, or in which the
+    // gate has settled closed and the outputs are simply cleared
+    struct EnvelopeRun { int endSample; bool isClosed; };
+    std::vector<EnvelopeRun> envelopeRuns;
+    void addEnvelopeRun(int endSample, bool isClosed) noexcept;
+
+    // Per-step parameters as used by the audio thread. Parameter listeners
+    // only flag the steps that changed; the table is refreshed at the start
+    // of the next block into the back copy, which is swapped in only if no
+    // pattern edit happened meanwhile.
+    std::array<StepTable<NUM_STEPS>, 2> stepTables;
+    int frontStepTable = 0;
+    const StepTable<NUM_STEPS>* stepTable = &stepTables[0];
+    std::atomic<juce::uint64> dirtySteps { ~juce::uint64(0) };
+
+    // Incremented when a pattern edit begins and when it ends (odd while editing)
+    std::atomic<juce::uint32> patternEditSequence { 0 };
+    int patternEditDepth = 0; // Message thread only
+
+    // Same, for state restores, which the host may run on any thread
+    std::atomic<juce::uint32> stateRestoreSequence { 0 };
+    juce::CriticalSection stateRestoreLock;
+
+    bool isRestoringState() const noexcept { return (stateRestoreSequence.load() & 1) != 0; }
+
+    void beginPatternEdit();
+    void endPatternEdit();
+
+    // Binary state: a header, then the plain values of the global parameters
+    // and of the per-step parameters, step by step, in the order of these IDs.
+    // Fields appended later are skipped by older versions, and missing ones
+    // get their default value: only incompatible changes need a new version.
+    static constexpr juce::uint32 binaryStateMagic = 0x61476852; // "RhGa"
+    static constexpr int binaryStateVersion = 1;
+    static constexpr std::array<const char*, 4> stateGlobalIDs { "METRIC", "STEPS", "ATTACK", "RELEASE" };
+    static constexpr std::array<const char*, 6> stateStepIDs { "ON", "DUR", "LVL", "AUX_LVL", "PAN", "LINK" };
+
+    // Parameters in the order of the binary state
+    std::vector<juce::RangedAudioParameter*> stateParams;
+
+    // Decode a state into the plain value of each parameter, by parameter
+    // index (NaN for the parameters the state does not hold)
+    bool readBinaryState(const void* data, int sizeInBytes, std::vector<float>& plainValues) const;
+    bool readXmlState(const void* data, int sizeInBytes, std::vector<float>& plainValues) const;
+    void restoreParameters(const std::vector<float>& plainValues);
+
+    // Sample-accurate changes of the current block, and the parameters they
+    // automate: the values set before the block must not be applied from its start
+    ParameterEventQueue<maxParameterEventsPerBlock> parameterEvents;
+    std::array<juce::uint64, numLinkedParameters> automatedSteps {};
+    bool isAttackAutomated = false;
+    bool isReleaseAutomated = false;
+
+    // Parameter objects by index, to convert the queued values
+    std::vector<juce::RangedAudioParameter*> parameterOfIndex;
+    int attackParamIndex = -1;
+    int releaseParamIndex = -1;
+
+    // Attack and release as used by the gate, which may change within a block
+    float currentAttackMs = 0.0f;
+    float currentReleaseMs = 0.0f;
+
+    void applyParameterEvent(const ParameterEvent& event);
+    void flushParameterEvents(int firstEvent);
+    void setStepParameter(StepTable<NUM_STEPS>& table, int step, int type, float value) noexcept;
+
+    // Publishes the playhead of a block, with its time and size, and counts its samples
+    void publishPlayhead(PlayheadRecord::State state, int numSamples) noexcept
+    {
+        state.samplePosition = numSamplesProcessed;
+        state.numSamples = numSamples;
+        state.sampleRate = currentSampleRate;
+        state.timeTicks = juce::Time::getHighResolutionTicks();
+        playheadRecord.publish(state);
+        numSamplesProcessed += numSamples;
+    }
+
+    // Step and LinkedParameter of each parameter index, or -1 for global parameters
+    struct StepParameterSlot { int step = -1; int type = -1; };
+    std::vector<StepParameterSlot> slotOfParameterIndex;
+
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int, bool) override {}
+    void updateStepTable();
+
+    // Channel layouts with a dedicated render path
+    enum class KernelLayout { mono, stereo, multichannel };
+
+    // PanGroup of each channel of the buses, set in prepareToPlay
+    std::vector<int> panGroupOfChannel;
+    KernelLayout kernelLayout = KernelLayout::stereo;
+    bool isAuxEnabled = true;
+
+    // Render kernels, specialized on the sample type, the channel layout and
+    // the Aux bus, so the hot path does not branch on configuration
+    template <typename SampleType>
+    using RenderKernel = void (RhythmicGateAudioProcessor::*)(juce::AudioBuffer<SampleType>&, juce::AudioBuffer<SampleType>&,
+                                                              int, int, double, double, float, float);
+    RenderKernel<float> floatRenderKernel = nullptr;
+    RenderKernel<double> doubleRenderKernel = nullptr;
+
+    // Metric and step count the gate scheduler's timing was set for
+    int timingNumSteps = -1;
+    int timingMetricIndex = -1;
+
+    // Step shown by the editor, and the PPQ range during which it stays current
+    GateScheduler::StepSpan activeStepSpan;
+
+    template <typename SampleType>
+    static RenderKernel<SampleType> getRenderKernel(KernelLayout layout, bool withAux);
+
+    // Shared implementation of the float and double processBlock
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer);
+
+    template <typename SampleType, KernelLayout Layout, bool WithAux>
+    void renderChunk(juce::AudioBuffer<SampleType>& mainOutputBuffer, juce::AudioBuffer<SampleType>& auxOutputBuffer,
+                     int startSample, int numSamples, double chunkPpq, double ppqPerSample,
+                     float attackMs, float releaseMs);
+
+    template <typename SampleType, KernelLayout Layout, bool WithAux>
+    void renderEnvelopes(double blockPpq, double ppqPerSample, int numSamples, float attackMs, float releaseMs);
+
+    float advanceEnvelope(double blockPpq, double ppqPerSample, int numSamples, float attackMs, float releaseMs);
+
+    void setGateTarget(float targetGain, float attackMs, float releaseMs);
+
+    template <typename SampleType>
+    static bool isSilent(const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples) noexcept;
+
+    template <typename SampleType, KernelLayout Layout, bool WithAux>
+    void applyEnvelopes(juce::AudioBuffer<SampleType>& mainOutputBuffer, juce::AudioBuffer<SampleType>& auxOutputBuffer,
+                        int startSample, int numSamples, bool measureLevels);
+
+    template <typename SampleType>
+    static void addLevels(const SampleType* data, int numSamples, float& peak, float& sumOfSquares) noexcept;
+
+    template <typename SampleType>
+    void feedScope(int numSamples);
+
+    // Link propagation, on the message thread
+    void propagateLinkedParameters();
+    void handleAsyncUpdate() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RhythmicGateAudioProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+    ProcessLoadMeter.h
+    Created: 16 Oct 2026 9:03:27pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Measures the time taken by each processBlock call, as a load: a percentage
+    of the real-time budget of the block (its duration at the sample rate).
+
+    The audio thread adds each block to a histogram with a few relaxed atomic
+    stores. Any other thread can take a snapshot of it, at any time, and
+    derive the p50/p99/max load since the start or between two snapshots.
+    Loads are binned in eighths of an octave, so the percentiles are within
+    about 5% of the actual values.
+*/
+class ProcessLoadMeter
+{
+public:
+    static constexpr int binsPerOctave = 8;
+    static constexpr int numBins = 16 * binsPerOctave;
+    static constexpr float minLoad = 0.01f; // Loads below fall in the first bin, loads above 655% in the last
+
+    struct Snapshot
+    {
+        std::array<juce::uint32, numBins> counts {};
+        juce::uint64 numBlocks = 0;
+        float lastLoad = 0.0f;
+        float maxLoad = 0.0f; // Since the start
+    };
+
+    struct Stats
+    {
+        juce::uint64 numBlocks = 0;
+        float lastLoad = 0.0f;
+        float p50Load = 0.0f;
+        float p99Load = 0.0f;
+        float maxLoad = 0.0f;
+    };
+
+    //==============================================================================
+    /** Times the block processed during its lifetime. */
+    class ScopedBlockTimer
+    {
+    public:
+        ScopedBlockTimer(ProcessLoadMeter& meterToUse, int numSamplesInBlock) noexcept
+            : meter(meterToUse), numSamples(numSamplesInBlock), startTicks(juce::Time::getHighResolutionTicks())
+        {
+        }
+
+        ~ScopedBlockTimer() noexcept
+        {
+            meter.addBlock(juce::Time::getHighResolutionTicks() - startTicks, numSamples);
+        }
+
+    private:
+        ProcessLoadMeter& meter;
+        int numSamples;
+        juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlockTimer)
+    };
+
+    //==============================================================================
+    /** Sets the sample rate of the blocks to come. Not to be called while processing. */
+    void prepare(double sampleRate) noexcept
+    {
+        ticksPerSample = (double) juce::Time::getHighResolutionTicksPerSecond() / sampleRate;
+    }
+
+    /** Adds a block, from the (single) thread processing the audio. */
+    void addBlock(juce::int64 elapsedTicks, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        const auto load = (float) (100.0 * (double) elapsedTicks / (ticksPerSample * numSamples));
+
+        // Only this thread writes, so a load and a store are enough
+        auto& count = counts[(size_t) getBin(load)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        lastLoad.store(load, std::memory_order_relaxed);
+        if (load > maxLoad.load(std::memory_order_relaxed))
+            maxLoad.store(load, std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    Snapshot getSnapshot() const noexcept
+    {
+        Snapshot snapshot;
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            snapshot.counts[(size_t) bin] = counts[(size_t) bin].load(std::memory_order_relaxed);
+            snapshot.numBlocks += snapshot.counts[(size_t) bin];
+        }
+
+        snapshot.lastLoad = lastLoad.load(std::memory_order_relaxed);
+        snapshot.maxLoad = maxLoad.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    /** Stats of the blocks added since the start. */
+    static Stats getStats(const Snapshot& current) noexcept
+    {
+        return getStats(current, Snapshot());
+    }
+
+    /** Stats of the blocks added between two snapshots. */
+    static Stats getStats(const Snapshot& current, const Snapshot& previous) noexcept
+    {
+        Stats stats;
+        stats.lastLoad = current.lastLoad;
+
+        std::array<juce::uint32, numBins> windowCounts;
+        int highestBin = -1;
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            windowCounts[(size_t) bin] = current.counts[(size_t) bin] - previous.counts[(size_t) bin];
+            stats.numBlocks += windowCounts[(size_t) bin];
+            if (windowCounts[(size_t) bin] > 0)
+                highestBin = bin;
+        }
+
+        if (stats.numBlocks == 0)
+            return stats;
+
+        auto getPercentile = [&] (double fraction)
+        {
+            const auto rank = (juce::uint64) std::ceil(fraction * (double) stats.numBlocks);
+            juce::uint64 numBelow = 0;
+            for (int bin = 0; bin < numBins; ++bin)
+            {
+                numBelow += windowCounts[(size_t) bin];
+                if (numBelow >= rank)
+                    return getBinLoad(bin, 0.5f);
+            }
+
+            return getBinLoad(numBins - 1, 0.5f);
+        };
+
+        stats.p50Load = getPercentile(0.5);
+        stats.p99Load = getPercentile(0.99);
+
+        // The exact maximum is only known since the start
+        stats.maxLoad = previous.numBlocks == 0 ? current.maxLoad
+                                                : juce::jmin(current.maxLoad, getBinLoad(highestBin, 1.0f));
+        return stats;
+    }
+
+private:
+    static int getBin(float load) noexcept
+    {
+        if (! (load > minLoad))
+            return 0;
+
+        return juce::jmin(numBins - 1, (int) ((float) binsPerOctave * std::log2(load / minLoad)));
+    }
+
+    // Load at a position within a bin (0 for its lower edge, 1 for its upper edge)
+    static float getBinLoad(int bin, float position) noexcept
+    {
+        return minLoad * std::exp2(((float) bin + position) / (float) binsPerOctave);
+    }
+
+    std::array<std::atomic<juce::uint32>, numBins> counts {};
+    std::atomic<float> lastLoad { 0.0f };
+    std::atomic<float> maxLoad { 0.0f };
+    double ticksPerSample = 1.0;
+};
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    ScopeFeed.h
+    Created: 17 Oct 2026 12:08:41am
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** The gate envelope and the output levels, decimated to a few hundred frames
+    per second, sent from the audio thread to the editor.
+
+    The audio thread adds the pieces of each rendered chunk; every
+    samplesPerFrame samples, a frame is pushed to a wait-free single producer,
+    single consumer FIFO. When the FIFO is full, the frame is dropped. The
+    storage is allocated at construction, so nothing is allocated while
+    processing.
+
+    The reader flags itself with addReader() and removeReader(): without
+    one, the audio thread measures nothing.
+*/
+class ScopeFeed
+{
+public:
+    static constexpr int capacity = 1024;            // Frames, about 5 s
+    static constexpr double framesPerSecond = 200.0;
+
+    struct Frame
+    {
+        float gate = 0.0f;     // Maximum of the gate envelope
+        float mainPeak = 0.0f; // Maximum over the channels of the bus
+        float mainRms = 0.0f;  // Over the channels of the bus
+        float auxPeak = 0.0f;
+        float auxRms = 0.0f;
+    };
+
+    ScopeFeed() : frames((size_t) capacity)
+    {
+    }
+
+    /** Sets the sample rate, and forgets the frames not read yet. Not to be
+        called while processing or reading.
+    */
+    void prepare(double sampleRate) noexcept
+    {
+        samplesPerFrame = juce::jmax(1, juce::roundToInt(sampleRate / framesPerSecond));
+        frameRate.store(sampleRate / samplesPerFrame, std::memory_order_relaxed);
+        fifo.reset();
+        startNewFrame();
+    }
+
+    //==============================================================================
+    /** Called by the reader when it starts and stops reading, from any thread. */
+    void addReader() noexcept     { ++numReaders; }
+    void removeReader() noexcept  { --numReaders; }
+
+    /** Returns true when a reader reads the frames, so that the chunks have
+        to be measured and added. When the first reader has just been added,
+        the current frame is started again. Audio thread only.
+    */
+    bool isFeeding() noexcept
+    {
+        const bool hasReader = numReaders.load(std::memory_order_relaxed) > 0;
+        if (hasReader && ! hadReader)
+            startNewFrame();
+
+        hadReader = hasReader;
+        return hasReader;
+    }
+
+    int getSamplesPerFrame() const noexcept { return samplesPerFrame; }
+
+    /** Number of samples that complete the current frame. */
+    int getNumSamplesToFrameEnd() const noexcept { return samplesPerFrame - numPendingSamples; }
+
+    /** Adds numSamples samples with the given envelope maximum, peaks and sums
+        of squares (averaged over the channels of each bus). They may span
+        several frames. Audio thread only.
+    */
+    void add(float gate, float mainPeak, float mainSquares, float auxPeak, float auxSquares, int numSamples) noexcept
+    {
+        for (;;)
+        {
+            const int numTaken = juce::jmin(numSamples, getNumSamplesToFrameEnd());
+            const float proportion = (float) numTaken / (float) numSamples;
+
+            pending.gate = juce::jmax(pending.gate, gate);
+            pending.mainPeak = juce::jmax(pending.mainPeak, mainPeak);
+            pending.auxPeak = juce::jmax(pending.auxPeak, auxPeak);
+            mainSumOfSquares += mainSquares * proportion;
+            auxSumOfSquares += auxSquares * proportion;
+            numPendingSamples += numTaken;
+
+            if (numPendingSamples == samplesPerFrame)
+                pushPendingFrame();
+
+            numSamples -= numTaken;
+            if (numSamples <= 0)
+                return;
+
+            mainSquares -= mainSquares * proportion;
+            auxSquares -= auxSquares * proportion;
+        }
+    }
+
+    //==============================================================================
+    /** Copies up to maxFrames of the oldest frames not read yet to dest, and
+        returns their number. Single reader.
+    */
+    int read(Frame* dest, int maxFrames) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(maxFrames, start1, size1, start2, size2);
+
+        std::copy_n(frames.begin() + start1, size1, dest);
+        std::copy_n(frames.begin() + start2, size2, dest + size1);
+
+        fifo.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+
+    double getFrameRate() const noexcept { return frameRate.load(std::memory_order_relaxed); }
+
+private:
+    void pushPendingFrame() noexcept
+    {
+        pending.mainRms = std::sqrt(mainSumOfSquares / (float) samplesPerFrame);
+        pending.auxRms = std::sqrt(auxSumOfSquares / (float) samplesPerFrame);
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 > 0)
+            frames[(size_t) start1] = pending;
+        fifo.finishedWrite(size1);
+
+        startNewFrame();
+    }
+
+    void startNewFrame() noexcept
+    {
+        pending = {};
+        numPendingSamples = 0;
+        mainSumOfSquares = auxSumOfSquares = 0.0f;
+    }
+
+    juce::AbstractFifo fifo { capacity };
+    std::vector<Frame> frames;
+    std::atomic<double> frameRate { framesPerSecond };
+    std::atomic<int> numReaders { 0 };
+
+    // Frame being accumulated by the audio thread
+    int samplesPerFrame = 1;
+    int numPendingSamples = 0;
+    Frame pending;
+    float mainSumOfSquares = 0.0f;
+    float auxSumOfSquares = 0.0f;
+    bool hadReader = false;
+};
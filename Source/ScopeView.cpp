@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    ScopeView.cpp
+    Created: 17 Oct 2026 12:31:09am
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#include "ScopeView.h"
+
+ScopeView::ScopeView(ScopeFeed& feedToRead)
+    : feed(feedToRead), history((size_t) historySize), readBuffer((size_t) ScopeFeed::capacity)
+{
+    columns.reserve(2048);
+    setOpaque(true);
+    setInterceptsMouseClicks(false, false);
+    feed.addReader();
+}
+
+ScopeView::~ScopeView()
+{
+    feed.removeReader();
+}
+
+void ScopeView::clear()
+{
+    while (feed.read(readBuffer.data(), (int) readBuffer.size()) > 0) {}
+
+    numFramesInHistory = 0;
+    repaint();
+}
+
+void ScopeView::refresh(double newSecondsShown)
+{
+    const int numRead = feed.read(readBuffer.data(), (int) readBuffer.size());
+
+    for (int i = 0; i < numRead; ++i)
+    {
+        history[(size_t) historyEnd] = readBuffer[(size_t) i];
+        historyEnd = (historyEnd + 1) % historySize;
+    }
+
+    numFramesInHistory = juce::jmin(historySize, numFramesInHistory + numRead);
+
+    if (numRead > 0 || newSecondsShown != secondsShown)
+    {
+        secondsShown = newSecondsShown;
+        repaint();
+    }
+}
+
+//==============================================================================
+void ScopeView::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colour::fromFloatRGBA(0.06f, 0.06f, 0.1f, 1.0f));
+
+    const auto width = getWidth();
+    const auto height = (float) getHeight();
+    const auto centreY = height * 0.5f;
+
+    const int numFramesShown = juce::jmin(numFramesInHistory, juce::roundToInt(secondsShown * feed.getFrameRate()));
+    if (width <= 0 || numFramesShown < 2)
+        return;
+
+    // One column per pixel, from the right, holding the maximum of its frames
+    const float framesPerPixel = (float) numFramesShown / (float) width;
+    columns.clear();
+
+    for (int x = 0; x < width; ++x)
+    {
+        const int firstFrame = (int) ((float) x * framesPerPixel);
+        const int endFrame = juce::jmin(numFramesShown, juce::jmax(firstFrame + 1, (int) ((float) (x + 1) * framesPerPixel)));
+        if (firstFrame >= numFramesShown)
+            break;
+
+        ScopeFeed::Frame column;
+        for (int frame = firstFrame; frame < endFrame; ++frame)
+        {
+            const auto& f = history[(size_t) ((historyEnd - 1 - frame + historySize) % historySize)];
+            column.gate = juce::jmax(column.gate, f.gate);
+            column.mainPeak = juce::jmax(column.mainPeak, juce::jmin(1.0f, f.mainPeak));
+            column.mainRms = juce::jmax(column.mainRms, juce::jmin(1.0f, f.mainRms));
+            column.auxPeak = juce::jmax(column.auxPeak, juce::jmin(1.0f, f.auxPeak));
+            column.auxRms = juce::jmax(column.auxRms, juce::jmin(1.0f, f.auxRms));
+        }
+
+        columns.push_back(column);
+    }
+
+    auto getX = [width] (size_t column) { return (float) width - (float) column; };
+
+    // The gate envelope, from the bottom
+    juce::Path gateOutline;
+    gateOutline.startNewSubPath(getX(0), height * (1.0f - columns.front().gate));
+    for (size_t x = 1; x < columns.size(); ++x)
+        gateOutline.lineTo(getX(x), height * (1.0f - columns[x].gate));
+
+    juce::Path gateArea(gateOutline);
+    gateArea.lineTo(getX(columns.size() - 1), height);
+    gateArea.lineTo(getX(0), height);
+    gateArea.closeSubPath();
+
+    // The levels from the centre line, Main upwards and Aux downwards
+    auto getLevelArea = [&] (float ScopeFeed::Frame::* level, float direction)
+    {
+        juce::Path area;
+        area.startNewSubPath(getX(0), centreY);
+        for (size_t x = 0; x < columns.size(); ++x)
+            area.lineTo(getX(x), centreY - direction * centreY * (columns[x].*level));
+        area.lineTo(getX(columns.size() - 1), centreY);
+        area.closeSubPath();
+        return area;
+    };
+
+    g.setColour(juce::Colours::white.withAlpha(0.08f));
+    g.fillPath(gateArea);
+    g.setColour(juce::Colours::white.withAlpha(0.35f));
+    g.strokePath(gateOutline, juce::PathStrokeType(1.0f));
+
+    g.setColour(juce::Colours::limegreen.withAlpha(0.3f));
+    g.fillPath(getLevelArea(&ScopeFeed::Frame::mainPeak, 1.0f));
+    g.setColour(juce::Colours::limegreen.withAlpha(0.6f));
+    g.fillPath(getLevelArea(&ScopeFeed::Frame::mainRms, 1.0f));
+
+    g.setColour(juce::Colours::cornflowerblue.withAlpha(0.3f));
+    g.fillPath(getLevelArea(&ScopeFeed::Frame::auxPeak, -1.0f));
+    g.setColour(juce::Colours::cornflowerblue.withAlpha(0.6f));
+    g.fillPath(getLevelArea(&ScopeFeed::Frame::auxRms, -1.0f));
+}
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    ScopeView.h
+    Created: 17 Oct 2026 12:31:09am
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/** A scrolling view of the gate envelope and the output levels, in an opaque
+    strip under the step grid: the newest frame is on the right, and the width
+    covers one pass of the sequence. The Main level is drawn above the centre
+    line and the Aux level below it.
+
+    Being opaque, the view repaints nothing but itself when it scrolls.
+
+    The frames come from the ScopeFeed of the processor, which only feeds
+    them while a view exists; the owner calls refresh() to read the new ones.
+    The view ignores the mouse.
+*/
+class ScopeView : public juce::Component
+{
+public:
+    explicit ScopeView(ScopeFeed& feed);
+    ~ScopeView() override;
+
+    void paint(juce::Graphics& g) override;
+
+    /** Reads the frames pushed since the last call, and repaints if there are
+        any. secondsShown is the duration across the width.
+    */
+    void refresh(double secondsShown);
+
+    /** Forgets the frames shown and the frames not read yet. */
+    void clear();
+
+private:
+    static constexpr int historySize = 4096; // Frames, about 20 s
+
+    ScopeFeed& feed;
+
+    std::vector<ScopeFeed::Frame> history;   // Ring of the last frames read
+    std::vector<ScopeFeed::Frame> readBuffer;
+    std::vector<ScopeFeed::Frame> columns;   // One per pixel, as last painted
+    int historyEnd = 0;                      // Index following the newest frame
+    int numFramesInHistory = 0;
+    double secondsShown = 2.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScopeView)
+};
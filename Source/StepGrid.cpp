@@ -0,0 +1,493 @@
+/*
+  ==============================================================================
+
+    StepGrid.cpp
+    Created: 16 Oct 2026 10:12:47pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#include "StepGrid.h"
+
+//==============================================================================
+// A cell, as seen by accessibility clients
+class StepGrid::CellAccessibility : public juce::Component
+{
+public:
+    CellAccessibility(juce::RangedAudioParameter& parameterToControl, bool isToggle)
+        : param(parameterToControl), isButton(isToggle)
+    {
+        setInterceptsMouseClicks(false, false);
+    }
+
+    std::unique_ptr<juce::AccessibilityHandler> createAccessibilityHandler() override
+    {
+        if (isButton)
+            return std::make_unique<ButtonHandler>(*this, param);
+
+        return std::make_unique<juce::AccessibilityHandler>(*this, juce::AccessibilityRole::slider, juce::AccessibilityActions(),
+                                                            juce::AccessibilityHandler::Interfaces { std::make_unique<ValueInterface>(param) });
+    }
+
+private:
+    struct ButtonHandler : public juce::AccessibilityHandler
+    {
+        ButtonHandler(CellAccessibility& cell, juce::RangedAudioParameter& parameter)
+            : juce::AccessibilityHandler(cell, juce::AccessibilityRole::toggleButton,
+                                         juce::AccessibilityActions().addAction(juce::AccessibilityActionType::toggle, [&parameter]
+                                         {
+                                             parameter.beginChangeGesture();
+                                             parameter.setValueNotifyingHost(parameter.getValue() < 0.5f ? 1.0f : 0.0f);
+                                             parameter.endChangeGesture();
+                                         })),
+              param(parameter)
+        {
+        }
+
+        juce::AccessibleState getCurrentState() const override
+        {
+            const auto state = juce::AccessibilityHandler::getCurrentState().withCheckable();
+            return param.getValue() >= 0.5f ? state.withChecked() : state;
+        }
+
+        juce::RangedAudioParameter& param;
+    };
+
+    struct ValueInterface : public juce::AccessibilityRangedNumericValueInterface
+    {
+        explicit ValueInterface(juce::RangedAudioParameter& parameter) : param(parameter) {}
+
+        bool isReadOnly() const override  { return false; }
+        double getCurrentValue() const override  { return param.getValue(); }
+
+        void setValue(double newValue) override
+        {
+            param.beginChangeGesture();
+            param.setValueNotifyingHost((float) newValue);
+            param.endChangeGesture();
+        }
+
+        juce::AccessibleValueRange getRange() const override  { return { { 0.0, 1.0 }, 0.01 }; }
+
+        juce::RangedAudioParameter& param;
+    };
+
+    juce::RangedAudioParameter& param;
+    const bool isButton;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CellAccessibility)
+};
+
+//==============================================================================
+StepGrid::StepGrid(RhythmicGateAudioProcessor& processor)
+{
+    setTitle("Steps");
+    cellOfParameterIndex.resize((size_t) processor.getParameters().size());
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        for (int step = 0; step < numSteps; ++step)
+        {
+            auto* param = processor.apvts.getParameter(ParameterID::get(step, getLaneStyles()[(size_t) lane].parameterType));
+            jassert(param != nullptr);
+
+            parameters[(size_t) lane][(size_t) step] = param;
+            values[(size_t) lane][(size_t) step] = param->getValue();
+            cellOfParameterIndex[(size_t) param->getParameterIndex()] = { lane, step };
+            param->addListener(this);
+        }
+    }
+}
+
+StepGrid::~StepGrid()
+{
+    // Destroyed while dragging: the host still expects the end of the gesture
+    if (dragStep >= 0)
+        parameters[(size_t) dragLane][(size_t) dragStep]->endChangeGesture();
+
+    for (auto& laneParameters : parameters)
+        for (auto* param : laneParameters)
+            param->removeListener(this);
+}
+
+const std::array<StepGrid::LaneStyle, StepGrid::numLanes>& StepGrid::getLaneStyles()
+{
+    // Same colours, proportions and margins as the former per-step components
+    static const std::array<LaneStyle, numLanes> styles
+    {{
+        { "ON",      "On",        juce::Colours::cyan,                 0.5f, juce::BorderSize<float>(2.0f),                    true,  false, false },
+        { "DUR",     "Duration",  juce::Colours::magenta.darker(1.2f), 1.0f, juce::BorderSize<float>(4.0f),                    false, true,  false },
+        { "PAN",     "Pan",       juce::Colours::orange.darker(),      1.0f, juce::BorderSize<float>(4.0f),                    false, true,  true  },
+        { "LVL",     "Level",     juce::Colours::green,                1.0f, juce::BorderSize<float>(4.0f),                    false, false, false },
+        { "AUX_LVL", "Aux level", juce::Colours::cornflowerblue,       1.0f, juce::BorderSize<float>(4.0f),                    false, false, false },
+        { "LINK",    "Link",      juce::Colours::grey.darker(),        0.5f, juce::BorderSize<float>(2.0f, 15.0f, 2.0f, 15.0f), true,  false, false }
+    }};
+
+    return styles;
+}
+
+//==============================================================================
+void StepGrid::resized()
+{
+    const auto& styles = getLaneStyles();
+
+    float totalFlex = 0.0f;
+    float totalMargin = 0.0f;
+    for (const auto& style : styles)
+    {
+        totalFlex += style.flex;
+        totalMargin += style.margin.getTopAndBottom();
+    }
+
+    const float heightPerFlex = juce::jmax(0.0f, (float) getHeight() - totalMargin) / totalFlex;
+
+    float y = 0.0f;
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        const auto& style = styles[(size_t) lane];
+        y += style.margin.getTop();
+        laneRanges[(size_t) lane] = { y, y + style.flex * heightPerFlex };
+        y = laneRanges[(size_t) lane].getEnd() + style.margin.getBottom();
+    }
+
+    staticLayer.invalidate();
+    updateCellAccessibilityBounds();
+}
+
+void StepGrid::createCellAccessibility()
+{
+    isCellAccessibilityPending = false;
+    if (! cellAccessibility.empty())
+        return;
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        for (int step = 0; step < numSteps; ++step)
+        {
+            auto cell = std::make_unique<CellAccessibility>(*parameters[(size_t) lane][(size_t) step], getLaneStyles()[(size_t) lane].isButton);
+            cell->setTitle("Step " + juce::String(step + 1) + " " + getLaneStyles()[(size_t) lane].name);
+            addAndMakeVisible(*cell);
+            cellAccessibility.push_back(std::move(cell));
+        }
+    }
+
+    updateCellAccessibilityBounds();
+
+    if (auto* handler = getAccessibilityHandler())
+        handler->notifyAccessibilityEvent(juce::AccessibilityEvent::structureChanged);
+}
+
+void StepGrid::updateCellAccessibilityBounds()
+{
+    if (cellAccessibility.empty())
+        return;
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        for (int step = 0; step < numSteps; ++step)
+        {
+            auto& cell = *cellAccessibility[(size_t) (lane * numSteps + step)];
+            cell.setBounds(getCellBounds(step, lane).getSmallestIntegerContainer());
+            cell.setVisible(step < numVisibleSteps);
+        }
+    }
+}
+
+std::unique_ptr<juce::AccessibilityHandler> StepGrid::createAccessibilityHandler()
+{
+    // Only asked for by accessibility clients: the cells are added after the
+    // handler exists, as adding children while it is created would ask for it again
+    if (cellAccessibility.empty() && ! isCellAccessibilityPending)
+    {
+        isCellAccessibilityPending = true;
+        juce::MessageManager::callAsync([safeThis = juce::Component::SafePointer<StepGrid>(this)]
+        {
+            if (safeThis != nullptr)
+                safeThis->createCellAccessibility();
+        });
+    }
+
+    return std::make_unique<juce::AccessibilityHandler>(*this, juce::AccessibilityRole::group);
+}
+
+juce::Rectangle<int> StepGrid::getColumnBounds(int step) const
+{
+    const int left = step * getWidth() / numSteps;
+    const int right = (step + 1) * getWidth() / numSteps;
+    return { left, 0, right - left, getHeight() };
+}
+
+juce::Rectangle<float> StepGrid::getCellBounds(int step, int lane) const
+{
+    const auto column = getColumnBounds(step).toFloat();
+    const auto& margin = getLaneStyles()[(size_t) lane].margin;
+    const auto& range = laneRanges[(size_t) lane];
+
+    return { column.getX() + margin.getLeft(), range.getStart(),
+             juce::jmax(0.0f, column.getWidth() - margin.getLeftAndRight()), range.getLength() };
+}
+
+bool StepGrid::getCellAt(juce::Point<float> position, int& step, int& lane) const
+{
+    if (getWidth() <= 0 || position.x < 0.0f || position.x >= (float) getWidth())
+        return false;
+
+    step = juce::jlimit(0, numSteps - 1, (int) (position.x * (float) numSteps / (float) getWidth()));
+    if (step >= numVisibleSteps)
+        return false;
+
+    for (lane = 0; lane < numLanes; ++lane)
+        if (getCellBounds(step, lane).contains(position))
+            return true;
+
+    return false;
+}
+
+float StepGrid::getValueAt(juce::Point<float> position, int step, int lane) const
+{
+    const auto bounds = getCellBounds(step, lane);
+    if (bounds.isEmpty())
+        return 0.0f;
+
+    const auto proportion = getLaneStyles()[(size_t) lane].isHorizontal
+                                ? (position.x - bounds.getX()) / bounds.getWidth()
+                                : (bounds.getBottom() - position.y) / bounds.getHeight();
+
+    return juce::jlimit(0.0f, 1.0f, proportion);
+}
+
+//==============================================================================
+void StepGrid::paint(juce::Graphics& g)
+{
+    staticLayer.draw(g, getLocalBounds(), [this] (juce::Graphics& layer) { paintStaticLayer(layer); });
+
+    const auto clip = g.getClipBounds();
+
+    for (int step = 0; step < numVisibleSteps; ++step)
+        if (getColumnBounds(step).intersects(clip))
+            for (int lane = 0; lane < numLanes; ++lane)
+                paintCell(g, step, lane);
+
+    // The active step is highlighted over its column
+    if (juce::isPositiveAndBelow(activeStep, numVisibleSteps))
+    {
+        const auto bounds = getColumnBounds(activeStep).toFloat();
+        g.setColour(juce::Colours::white.withAlpha(0.25f));
+        g.fillRoundedRectangle(bounds, 4.0f);
+        g.setColour(juce::Colours::white.withAlpha(0.6f));
+        g.drawRoundedRectangle(bounds.reduced(1.0f), 4.0f, 2.0f);
+    }
+
+    if (cursorX >= 0.0f)
+    {
+        g.setColour(juce::Colours::white.withAlpha(0.9f));
+        g.fillRect(cursorX - 1.0f, 0.0f, 2.0f, (float) getHeight());
+    }
+}
+
+void StepGrid::paintStaticLayer(juce::Graphics& g) const
+{
+    const auto& styles = getLaneStyles();
+
+    for (int step = 0; step < numVisibleSteps; ++step)
+    {
+        if (accentPeriod > 0 && step % accentPeriod == 0)
+        {
+            g.setColour(juce::Colour::fromFloatRGBA (0.25f, 0.25f, 0.3f, 1.0f));
+            g.fillRoundedRectangle(getColumnBounds(step).toFloat(), 4.0f);
+        }
+
+        g.setColour(juce::Colours::black.withAlpha(0.3f));
+        for (int lane = 0; lane < numLanes; ++lane)
+            if (! styles[(size_t) lane].isButton)
+                g.fillRoundedRectangle(getCellBounds(step, lane), 2.0f);
+    }
+}
+
+void StepGrid::paintCell(juce::Graphics& g, int step, int lane) const
+{
+    const auto& style = getLaneStyles()[(size_t) lane];
+    const auto bounds = getCellBounds(step, lane);
+    const float value = values[(size_t) lane][(size_t) step];
+
+    if (style.isButton)
+    {
+        const bool isOn = value >= 0.5f;
+        g.setColour(isOn ? style.colour : style.colour.withAlpha(0.15f));
+        g.fillRoundedRectangle(bounds, 3.0f);
+        g.setColour(style.colour.withAlpha(isOn ? 1.0f : 0.6f));
+        g.drawRoundedRectangle(bounds.reduced(0.5f), 3.0f, 1.0f);
+        return;
+    }
+
+    juce::Rectangle<float> bar;
+    if (! style.isHorizontal)
+        bar = bounds.withTop(bounds.getBottom() - value * bounds.getHeight());
+    else if (style.drawFromCentre)
+        bar = juce::Rectangle<float>::leftTopRightBottom(juce::jmin(bounds.getCentreX(), bounds.getX() + value * bounds.getWidth()), bounds.getY(),
+                                                         juce::jmax(bounds.getCentreX(), bounds.getX() + value * bounds.getWidth()), bounds.getBottom());
+    else
+        bar = bounds.withWidth(value * bounds.getWidth());
+
+    g.setColour(style.colour);
+    g.fillRoundedRectangle(bar, 2.0f);
+}
+
+//==============================================================================
+void StepGrid::mouseDown(const juce::MouseEvent& event)
+{
+    int step, lane;
+    if (! getCellAt(event.position, step, lane))
+        return;
+
+    auto* param = parameters[(size_t) lane][(size_t) step];
+
+    if (getLaneStyles()[(size_t) lane].isButton)
+    {
+        param->beginChangeGesture();
+        param->setValueNotifyingHost(param->getValue() < 0.5f ? 1.0f : 0.0f);
+        param->endChangeGesture();
+        return;
+    }
+
+    // The bars jump to the clicked value, then follow the drag
+    dragStep = step;
+    dragLane = lane;
+    param->beginChangeGesture();
+    param->setValueNotifyingHost(getValueAt(event.position, step, lane));
+}
+
+void StepGrid::mouseDrag(const juce::MouseEvent& event)
+{
+    if (dragStep >= 0)
+        parameters[(size_t) dragLane][(size_t) dragStep]->setValueNotifyingHost(getValueAt(event.position, dragStep, dragLane));
+}
+
+void StepGrid::mouseUp(const juce::MouseEvent&)
+{
+    if (dragStep >= 0)
+        parameters[(size_t) dragLane][(size_t) dragStep]->endChangeGesture();
+
+    dragStep = -1;
+    dragLane = -1;
+}
+
+void StepGrid::mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel)
+{
+    int step, lane;
+    if (dragStep >= 0 || ! getCellAt(event.position, step, lane) || getLaneStyles()[(size_t) lane].isButton)
+    {
+        Component::mouseWheelMove(event, wheel);
+        return;
+    }
+
+    // Same steps as the former sliders
+    const auto delta = (wheel.deltaX != 0.0f ? -wheel.deltaX : wheel.deltaY) * (wheel.isReversed ? -0.15f : 0.15f);
+    if (delta == 0.0f)
+        return;
+
+    auto* param = parameters[(size_t) lane][(size_t) step];
+    param->beginChangeGesture();
+    param->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, param->getValue() + delta));
+    param->endChangeGesture();
+}
+
+//==============================================================================
+void StepGrid::parameterValueChanged(int parameterIndex, float)
+{
+    // May be called on any thread: only flag the cell
+    if (! juce::isPositiveAndBelow(parameterIndex, (int) cellOfParameterIndex.size()))
+        return;
+
+    const auto cell = cellOfParameterIndex[(size_t) parameterIndex];
+    if (cell.lane >= 0)
+        dirtySteps[(size_t) cell.lane].fetch_or(juce::uint64(1) << cell.step);
+}
+
+void StepGrid::refresh()
+{
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        auto mask = dirtySteps[(size_t) lane].exchange(0);
+
+        for (int step = 0; mask != 0; ++step, mask >>= 1)
+        {
+            if ((mask & 1) == 0)
+                continue;
+
+            const float value = parameters[(size_t) lane][(size_t) step]->getValue();
+            if (value == values[(size_t) lane][(size_t) step])
+                continue;
+
+            values[(size_t) lane][(size_t) step] = value;
+            if (step < numVisibleSteps)
+                repaint(getCellBounds(step, lane).getSmallestIntegerContainer());
+
+            if (! cellAccessibility.empty())
+                if (auto* handler = cellAccessibility[(size_t) (lane * numSteps + step)]->getAccessibilityHandler())
+                    handler->notifyAccessibilityEvent(juce::AccessibilityEvent::valueChanged);
+        }
+    }
+}
+
+void StepGrid::setNumVisibleSteps(int newNumSteps)
+{
+    if (numVisibleSteps != newNumSteps)
+    {
+        numVisibleSteps = newNumSteps;
+        staticLayer.invalidate();
+        updateCellAccessibilityBounds();
+        repaint();
+    }
+}
+
+void StepGrid::setPlayheadPosition(double position)
+{
+    const int step = position >= 0.0 ? juce::jmin((int) position, numSteps - 1) : -1;
+
+    float x = -1.0f;
+    if (juce::isPositiveAndBelow(step, numVisibleSteps))
+    {
+        const auto column = getColumnBounds(step).toFloat();
+        x = column.getX() + (float) (position - step) * column.getWidth();
+    }
+
+    if (activeStep != step)
+    {
+        if (juce::isPositiveAndBelow(activeStep, numSteps))
+            repaint(getColumnBounds(activeStep));
+
+        activeStep = step;
+
+        if (juce::isPositiveAndBelow(activeStep, numSteps))
+            repaint(getColumnBounds(activeStep));
+    }
+
+    // Only the strips under the old and the new cursor are repainted
+    if (std::abs(x - cursorX) >= 0.25f)
+    {
+        if (cursorX >= 0.0f)
+            repaint(getCursorBounds());
+
+        cursorX = x;
+
+        if (cursorX >= 0.0f)
+            repaint(getCursorBounds());
+    }
+}
+
+juce::Rectangle<int> StepGrid::getCursorBounds() const
+{
+    return { (int) std::floor(cursorX) - 2, 0, 4, getHeight() };
+}
+
+void StepGrid::setAccentPeriod(int period)
+{
+    if (accentPeriod != period)
+    {
+        accentPeriod = period;
+        staticLayer.invalidate();
+        repaint();
+    }
+}
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    StepGrid.h
+    Created: 16 Oct 2026 10:12:47pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "CachedLayer.h"
+
+//==============================================================================
+/** The per-step controls of every step, in one component: a column per step
+    with its On/Off button, Duration, Pan, Level and Aux bars, and Link button.
+
+    The grid paints the columns and hit-tests the mouse itself. It listens to
+    all the per-step parameters through a single listener, which only flags
+    the cells that changed: the owner calls refresh() from its timer, and
+    only these cells are repainted.
+
+    The accents and the bar backgrounds are cached in an image; the values,
+    the active step highlight and the playhead cursor are drawn over it.
+
+    For accessibility, each cell gets an empty child component, which neither
+    paints nor takes the mouse: the bars are exposed as sliders and the
+    buttons as toggle buttons. These components are only created once an
+    accessibility client asks for the grid's handler; until then the grid
+    has no children.
+*/
+class StepGrid : public juce::Component,
+                 private juce::AudioProcessorParameter::Listener
+{
+public:
+    explicit StepGrid(RhythmicGateAudioProcessor& processor);
+    ~StepGrid() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    void mouseDown(const juce::MouseEvent& event) override;
+    void mouseDrag(const juce::MouseEvent& event) override;
+    void mouseUp(const juce::MouseEvent& event) override;
+    void mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel) override;
+
+    std::unique_ptr<juce::AccessibilityHandler> createAccessibilityHandler() override;
+
+    /** Repaints the cells whose parameter changed since the last call. */
+    void refresh();
+
+    void setNumVisibleSteps(int numSteps);
+    void setAccentPeriod(int period); // Every period-th step is accented
+
+    /** Sets the position of the playhead, in steps (3.5 is the middle of the
+        fourth step), or -1 to hide it. The step under the playhead is
+        highlighted, and a cursor shows the position within it.
+    */
+    void setPlayheadPosition(double position);
+
+private:
+    static constexpr int numSteps = RhythmicGateAudioProcessor::NUM_STEPS;
+
+    // Rows of a column, from top to bottom
+    enum Lane { onOffLane, durationLane, panLane, levelLane, auxLane, linkLane, numLanes };
+
+    struct LaneStyle
+    {
+        const char* parameterType;
+        const char* name;
+        juce::Colour colour;
+        float flex;
+        juce::BorderSize<float> margin;
+        bool isButton;
+        bool isHorizontal;
+        bool drawFromCentre;
+    };
+
+    static const std::array<LaneStyle, numLanes>& getLaneStyles();
+
+    juce::Rectangle<float> getCellBounds(int step, int lane) const;
+    juce::Rectangle<int> getColumnBounds(int step) const;
+    bool getCellAt(juce::Point<float> position, int& step, int& lane) const;
+    float getValueAt(juce::Point<float> position, int step, int lane) const;
+
+    void paintStaticLayer(juce::Graphics& g) const;
+    void paintCell(juce::Graphics& g, int step, int lane) const;
+    juce::Rectangle<int> getCursorBounds() const;
+    void createCellAccessibility();
+    void updateCellAccessibilityBounds();
+
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int, bool) override {}
+
+    std::array<std::array<juce::RangedAudioParameter*, numSteps>, numLanes> parameters;
+    std::array<std::array<float, numSteps>, numLanes> values; // Normalised, as last painted
+
+    // Lane and step of each parameter index, or -1 for the others
+    struct Cell { int lane = -1; int step = -1; };
+    std::vector<Cell> cellOfParameterIndex;
+
+    // Cells changed since the last refresh, one bit per step, by lane
+    std::array<std::atomic<juce::uint64>, numLanes> dirtySteps {};
+
+    CachedLayer staticLayer;
+
+    // Vertical extent of each lane in a column, set in resized
+    std::array<juce::Range<float>, numLanes> laneRanges;
+
+    int numVisibleSteps = numSteps;
+    int activeStep = -1;
+    float cursorX = -1.0f; // Playhead cursor, -1 when hidden
+    int accentPeriod = 4;
+
+    // Cell being dragged
+    int dragStep = -1;
+    int dragLane = -1;
+
+    class CellAccessibility;
+    std::vector<std::unique_ptr<CellAccessibility>> cellAccessibility; // By lane, then step, once created
+    bool isCellAccessibilityPending = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StepGrid)
+};
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    StepTable.h
+    Created: 16 Oct 2026 11:02:37am
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Which pan gain a channel of the bus follows. */
+enum PanGroup
+{
+    leftPanGroup,    // Left-hand channels (L, Ls, Lss, Ltf...)
+    rightPanGroup,   // Right-hand channels (R, Rs, Rss, Rtf...)
+    unpannedGroup,   // Mono, centre, LFE, ambisonic and discrete channels
+    numPanGroups
+};
+
+inline PanGroup getPanGroup(juce::AudioChannelSet::ChannelType type)
+{
+    using Set = juce::AudioChannelSet;
+
+    switch (type)
+    {
+        case Set::left:
+        case Set::leftSurround:
+        case Set::leftCentre:
+        case Set::leftSurroundSide:
+        case Set::leftSurroundRear:
+        case Set::wideLeft:
+        case Set::topFrontLeft:
+        case Set::topRearLeft:
+        case Set::topSideLeft:
+            return leftPanGroup;
+
+        case Set::right:
+        case Set::rightSurround:
+        case Set::rightCentre:
+        case Set::rightSurroundSide:
+        case Set::rightSurroundRear:
+        case Set::wideRight:
+        case Set::topFrontRight:
+        case Set::topRearRight:
+        case Set::topSideRight:
+            return rightPanGroup;
+
+        default:
+            return unpannedGroup;
+    }
+}
+
+//==============================================================================
+/** Snapshot of the per-step parameters in the form the gate engine uses them:
+    one contiguous array per field (structure of arrays), with the levels
+    already converted to linear gains and the pan already converted to
+    constant-power gains for each PanGroup.
+*/
+template <int NumSteps>
+struct alignas(64) StepTable
+{
+    alignas(64) std::array<float, NumSteps> onOff {};
+    alignas(64) std::array<float, NumSteps> duration {};
+    alignas(64) std::array<float, NumSteps> mainGain {};
+    alignas(64) std::array<float, NumSteps> auxGain {};
+    alignas(64) std::array<std::array<float, NumSteps>, numPanGroups> panGains {};
+
+    bool isOn(int step) const noexcept { return onOff[step] > 0.5f; }
+
+    /** Recomputes a step from its raw parameter values. */
+    void setStep(int step, float isOnValue, float durationValue,
+                 float levelDb, float auxLevelDb, float pan) noexcept
+    {
+        setOnOff(step, isOnValue);
+        setDuration(step, durationValue);
+        setLevel(step, levelDb);
+        setAuxLevel(step, auxLevelDb);
+        setPan(step, pan);
+    }
+
+    // Setters for a single raw parameter value of a step
+    void setOnOff(int step, float isOnValue) noexcept       { onOff[step] = isOnValue; }
+    void setDuration(int step, float durationValue) noexcept { duration[step] = durationValue; }
+    void setLevel(int step, float levelDb) noexcept          { mainGain[step] = juce::Decibels::decibelsToGain(levelDb); }
+    void setAuxLevel(int step, float auxLevelDb) noexcept    { auxGain[step] = juce::Decibels::decibelsToGain(auxLevelDb); }
+
+    void setPan(int step, float pan) noexcept
+    {
+        // Constant-power pan law, pan from -1 (L) to 1 (R)
+        panGains[leftPanGroup][step] = std::sqrt(0.5f * (1.0f - pan));
+        panGains[rightPanGroup][step] = std::sqrt(0.5f * (1.0f + pan));
+        panGains[unpannedGroup][step] = 1.0f;
+    }
+};
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    TraceEvents.cpp
+    Created: 16 Oct 2026 9:41:06pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#include "TraceEvents.h"
+
+#if RHYGA_ENABLE_TRACING
+namespace TraceEvents
+{
+    struct Event
+    {
+        const char* name;
+        juce::int64 startTicks;
+        juce::int64 endTicks;
+    };
+
+    // Events of one track, written by one thread at a time
+    struct TrackBuffer
+    {
+        static constexpr juce::uint64 capacity = 1 << 16;
+
+        Event events[capacity] {};
+        std::atomic<juce::uint64> numWritten { 0 };
+        std::atomic<bool> isClaimed { false };
+        char name[64] {}; // Set before isClaimed
+    };
+
+    // A fixed pool, in static storage. The writers beyond the pool record no events.
+    static constexpr int maxTracks = 16;
+    static TrackBuffer trackBuffers[maxTracks];
+    static std::atomic<int> numClaimedTracks { 0 };
+    static const juce::int64 originTicks = juce::Time::getHighResolutionTicks();
+
+    int claimTrack(const juce::String& name)
+    {
+        const auto track = numClaimedTracks.fetch_add(1, std::memory_order_relaxed);
+        if (track >= maxTracks)
+            return -1;
+
+        auto& buffer = trackBuffers[track];
+        name.copyToUTF8(buffer.name, sizeof(buffer.name));
+        buffer.isClaimed.store(true, std::memory_order_release);
+        return track;
+    }
+
+    int getMessageThreadTrack()
+    {
+        jassert(juce::MessageManager::existsAndIsCurrentThread());
+
+        static const int track = claimTrack("Message thread");
+        return track;
+    }
+
+    void record(int track, const char* name, juce::int64 startTicks, juce::int64 endTicks) noexcept
+    {
+        if (! juce::isPositiveAndBelow(track, maxTracks))
+            return;
+
+        auto& buffer = trackBuffers[track];
+        const auto index = buffer.numWritten.load(std::memory_order_relaxed);
+        buffer.events[index % TrackBuffer::capacity] = { name, startTicks, endTicks };
+        buffer.numWritten.store(index + 1, std::memory_order_release);
+    }
+
+    bool writeChromeTrace(const juce::File& file)
+    {
+        struct TrackEvents
+        {
+            int trackIndex;
+            juce::String trackName;
+            std::vector<Event> events;
+        };
+
+        // First a copy of the buffers, taken while their writers may still write
+        // to them; the file is written afterwards
+        std::vector<TrackEvents> snapshot;
+        const auto numBuffers = juce::jmin(maxTracks, numClaimedTracks.load(std::memory_order_relaxed));
+
+        for (int i = 0; i < numBuffers; ++i)
+        {
+            const auto& buffer = trackBuffers[i];
+            if (! buffer.isClaimed.load(std::memory_order_acquire))
+                continue;
+
+            const auto numWritten = buffer.numWritten.load(std::memory_order_acquire);
+            const auto first = numWritten > TrackBuffer::capacity ? numWritten - TrackBuffer::capacity : 0;
+            std::vector<Event> events;
+            events.reserve((size_t) (numWritten - first));
+            for (auto index = first; index < numWritten; ++index)
+                events.push_back(buffer.events[index % TrackBuffer::capacity]);
+
+            // Drop the events that may have been overwritten during the copy
+            const auto numWrittenAfter = buffer.numWritten.load(std::memory_order_acquire);
+            const auto firstIntact = numWrittenAfter >= TrackBuffer::capacity ? numWrittenAfter - TrackBuffer::capacity + 1 : 0;
+            if (firstIntact > first)
+                events.erase(events.begin(), events.begin() + (std::ptrdiff_t) juce::jmin(firstIntact - first, (juce::uint64) events.size()));
+
+            snapshot.push_back({ i + 1, juce::String::fromUTF8(buffer.name), std::move(events) });
+        }
+
+        file.deleteFile();
+        juce::FileOutputStream stream(file);
+        if (stream.failedToOpen())
+            return false;
+
+        const auto ticksPerMicrosecond = (double) juce::Time::getHighResolutionTicksPerSecond() * 1.0e-6;
+        auto toMicroseconds = [&] (juce::int64 ticks) { return juce::String((double) ticks / ticksPerMicrosecond, 3); };
+
+        stream << "{\"traceEvents\":[";
+        const char* separator = "\n";
+
+        for (const auto& track : snapshot)
+        {
+            stream << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << track.trackIndex
+                   << ",\"args\":{\"name\":" << juce::JSON::toString(track.trackName) << "}}";
+            separator = ",\n";
+
+            for (const auto& event : track.events)
+                stream << separator << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << track.trackIndex
+                       << ",\"ts\":" << toMicroseconds(event.startTicks - originTicks)
+                       << ",\"dur\":" << toMicroseconds(event.endTicks - event.startTicks) << "}";
+        }
+
+        stream << "\n]}\n";
+        stream.flush();
+        return stream.getStatus().wasOk();
+    }
+}
+#endif
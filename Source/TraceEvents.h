@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    TraceEvents.h
+    Created: 16 Oct 2026 9:41:06pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Trace markers on the hot sections, for builds defining RHYGA_ENABLE_TRACING=1.
+// Without it, RHYGA_TRACE_SCOPE compiles to nothing.
+#ifndef RHYGA_ENABLE_TRACING
+ #define RHYGA_ENABLE_TRACING 0
+#endif
+
+#if RHYGA_ENABLE_TRACING
+//==============================================================================
+/** Timed events, kept in a ring buffer per track and exported as Chrome
+    trace-event JSON (chrome://tracing, ui.perfetto.dev).
+
+    A track is a buffer of a fixed pool in static storage, claimed up front
+    by its writer: each processor claims one for its audio callbacks, and the
+    message thread has its own. Tracks are passed explicitly rather than
+    found through thread-local storage, whose first access in a plugin may
+    allocate. Recording an event reads the clock and stores three words,
+    without locking. When a buffer is full, its oldest events are
+    overwritten. Writers beyond the pool are not traced.
+*/
+namespace TraceEvents
+{
+    /** Claims a track of the pool, shown under the given name. Call it outside
+        real-time code. Tracks are never released; returns -1 (recording
+        nothing) once the pool is used up.
+    */
+    int claimTrack(const juce::String& name);
+
+    /** Returns the track of the message thread, claimed by the first call.
+        Call it on the message thread.
+    */
+    int getMessageThreadTrack();
+
+    /** Records an event on a track. Only one thread at a time may write to a
+        track. name must be a string literal.
+    */
+    void record(int track, const char* name, juce::int64 startTicks, juce::int64 endTicks) noexcept;
+
+    /** Writes the events held by the buffers of all threads to a JSON file. */
+    bool writeChromeTrace(const juce::File& file);
+
+    /** Records an event lasting as long as this object. */
+    class ScopedEvent
+    {
+    public:
+        ScopedEvent(int eventTrack, const char* eventName) noexcept
+            : track(eventTrack), name(eventName), startTicks(juce::Time::getHighResolutionTicks())
+        {
+        }
+
+        ~ScopedEvent() noexcept
+        {
+            record(track, name, startTicks, juce::Time::getHighResolutionTicks());
+        }
+
+    private:
+        int track;
+        const char* name;
+        juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedEvent)
+    };
+}
+
+ #define RHYGA_TRACE_SCOPE(track, name) const TraceEvents::ScopedEvent JUCE_JOIN_MACRO(traceEvent_, __LINE__) (track, name)
+#else
+ #define RHYGA_TRACE_SCOPE(track, name)
+#endif
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 16 Oct 2026 7:12:40pm
+    Author:  doare
+
+    Applies a RhyGa pattern to audio files, without a host.
+
+    Usage: RhyGaBatch --state <file> --bpm <bpm> [--start-ppq <ppq>]
+                      [--output <folder>] [--threads <n>] [--no-aux] <files...>
+
+    The state file holds a state saved by the plugin (the data returned by
+    getStateInformation). Each input file (WAV, AIFF or FLAC) is streamed
+    block by block through the gate, with its first sample at --start-ppq
+    on a timeline of constant tempo. The Main and Aux outputs are written
+    next to it, or to the output folder, as <name>_main.<ext> and
+    <name>_aux.<ext>, in the format and bit depth of the input.
+    The files are processed in parallel, one per thread.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/OfflineGateRenderer.h"
+
+//==============================================================================
+struct BatchSettings
+{
+    double bpm = 120.0;
+    double startPpq = 0.0;
+    juce::File outputFolder;
+    bool writeAux = true;
+};
+
+// Samples read, rendered and written at a time, so that the memory used does
+// not depend on the length of the files
+static constexpr int blockSize = 1 << 16;
+
+static std::unique_ptr<juce::AudioFormatReader> createReader(juce::AudioFormatManager& formatManager, const juce::File& file)
+{
+    // Memory-mapped where the format supports it (WAV, AIFF), streamed otherwise (FLAC)
+    if (auto* format = formatManager.findFormatForFileExtension(file.getFileExtension()))
+    {
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader(format->createMemoryMappedReader(file));
+        if (mappedReader != nullptr && mappedReader->mapEntireFile())
+            return mappedReader;
+    }
+
+    return std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(file));
+}
+
+static std::unique_ptr<juce::AudioFormatWriter> createWriter(juce::AudioFormatManager& formatManager, const juce::File& file,
+                                                             const juce::AudioFormatReader& reader)
+{
+    auto* format = formatManager.findFormatForFileExtension(file.getFileExtension());
+    if (format == nullptr)
+        return {};
+
+    file.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream(file.createOutputStream());
+    if (stream == nullptr)
+        return {};
+
+    // Keep the bit depth of the input when the format supports it
+    const auto bitDepths = format->getPossibleBitDepths();
+    const int bitsPerSample = bitDepths.contains((int) reader.bitsPerSample) ? (int) reader.bitsPerSample : bitDepths.getLast();
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), reader.sampleRate, reader.numChannels,
+                                                                            bitsPerSample, reader.metadataValues, 0));
+    if (writer != nullptr)
+        stream.release(); // Now owned by the writer
+
+    return writer;
+}
+
+static juce::AudioChannelSet getChannelSet(int numChannels)
+{
+    auto channelSet = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+    return channelSet.size() == numChannels ? channelSet : juce::AudioChannelSet::discreteChannels(numChannels);
+}
+
+/** Renders one file. Returns an error message, or an empty string on success. */
+static juce::String processFile(RhythmicGateAudioProcessor& processor, const juce::File& file, const BatchSettings& settings)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto reader = createReader(formatManager, file);
+    if (reader == nullptr)
+        return "cannot read the file";
+
+    const int numChannels = (int) reader->numChannels;
+    const OfflineGateRenderer renderer(processor, getChannelSet(numChannels), reader->sampleRate, settings.bpm, settings.startPpq);
+
+    const auto folder = settings.outputFolder == juce::File() ? file.getParentDirectory() : settings.outputFolder;
+    auto getOutputFile = [&] (const juce::String& suffix)
+    {
+        return folder.getChildFile(file.getFileNameWithoutExtension() + suffix + file.getFileExtension());
+    };
+
+    auto mainWriter = createWriter(formatManager, getOutputFile("_main"), *reader);
+    auto auxWriter = settings.writeAux ? createWriter(formatManager, getOutputFile("_aux"), *reader) : nullptr;
+    if (mainWriter == nullptr || (settings.writeAux && auxWriter == nullptr))
+        return "cannot write to " + folder.getFullPathName();
+
+    juce::AudioBuffer<float> input(numChannels, blockSize);
+    juce::AudioBuffer<float> mainOutput(numChannels, blockSize);
+    juce::AudioBuffer<float> auxOutput(settings.writeAux ? numChannels : 0, blockSize);
+
+    // The blocks follow each other: the envelope is carried from one to the next
+    OfflineGateRenderer::EnvelopeState envelopeState;
+
+    for (juce::int64 position = 0; position < reader->lengthInSamples; position += blockSize)
+    {
+        const int numSamples = (int) juce::jmin((juce::int64) blockSize, reader->lengthInSamples - position);
+
+        // The last block is shorter: only the sizes change, nothing is reallocated
+        input.setSize(input.getNumChannels(), numSamples, false, false, true);
+        mainOutput.setSize(mainOutput.getNumChannels(), numSamples, false, false, true);
+        auxOutput.setSize(auxOutput.getNumChannels(), numSamples, false, false, true);
+
+        if (! reader->read(&input, 0, numSamples, position, true, true))
+            return "read error";
+
+        renderer.render(input, mainOutput, auxOutput, position, envelopeState);
+
+        if (! mainWriter->writeFromAudioSampleBuffer(mainOutput, 0, numSamples)
+            || (auxWriter != nullptr && ! auxWriter->writeFromAudioSampleBuffer(auxOutput, 0, numSamples)))
+            return "write error";
+    }
+
+    return {};
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    auto getOption = [&args] (const juce::String& name) -> juce::String
+    {
+        const int index = args.indexOf(name);
+        return index >= 0 && index + 1 < args.size() ? args[index + 1] : juce::String();
+    };
+
+    // Everything that is neither an option nor the value of an option is an input file
+    static const juce::StringArray optionsWithValue { "--state", "--bpm", "--start-ppq", "--output", "--threads" };
+    juce::Array<juce::File> files;
+    for (int i = 0; i < args.size(); ++i)
+    {
+        if (optionsWithValue.contains(args[i]))
+            ++i;
+        else if (! args[i].startsWith("--"))
+            files.add(juce::File::getCurrentWorkingDirectory().getChildFile(args[i]));
+    }
+
+    if (! args.contains("--state") || ! args.contains("--bpm") || files.isEmpty())
+    {
+        std::cout << "Usage: RhyGaBatch --state <file> --bpm <bpm> [--start-ppq <ppq>]" << std::endl
+                  << "                  [--output <folder>] [--threads <n>] [--no-aux] <files...>" << std::endl;
+        return 1;
+    }
+
+    juce::MemoryBlock state;
+    const auto stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(getOption("--state"));
+    if (! stateFile.loadFileAsData(state))
+    {
+        std::cout << "Cannot read " << stateFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    RhythmicGateAudioProcessor processor;
+    processor.setStateInformation(state.getData(), (int) state.getSize());
+
+    BatchSettings settings;
+    settings.bpm = getOption("--bpm").getDoubleValue();
+    settings.startPpq = getOption("--start-ppq").getDoubleValue();
+    settings.writeAux = ! args.contains("--no-aux");
+    if (args.contains("--output"))
+    {
+        settings.outputFolder = juce::File::getCurrentWorkingDirectory().getChildFile(getOption("--output"));
+        settings.outputFolder.createDirectory();
+    }
+
+    if (settings.bpm <= 0.0)
+    {
+        std::cout << "Invalid tempo" << std::endl;
+        return 1;
+    }
+
+    const int numThreads = args.contains("--threads") ? juce::jmax(1, getOption("--threads").getIntValue())
+                                                      : juce::SystemStats::getNumCpus();
+    juce::ThreadPool pool(numThreads);
+
+    std::atomic<int> numPendingFiles { files.size() };
+    std::atomic<int> numFailedFiles { 0 };
+    juce::WaitableEvent allFilesProcessed;
+    juce::CriticalSection outputLock;
+
+    for (const auto& file : files)
+    {
+        pool.addJob([&, file]
+        {
+            const auto error = processFile(processor, file, settings);
+
+            {
+                const juce::ScopedLock lock(outputLock);
+                std::cout << file.getFullPathName() << ": " << (error.isEmpty() ? "done" : error) << std::endl;
+            }
+
+            if (error.isNotEmpty())
+                ++numFailedFiles;
+
+            if (--numPendingFiles == 0)
+                allFilesProcessed.signal();
+        });
+    }
+
+    allFilesProcessed.wait();
+    return numFailedFiles == 0 ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    BaselineRender.h
+    Created: 16 Oct 2026 6:05:12pm
+    Author:  doare
+
+    The gate of the original per-sample processBlock (before the segment
+    renderer, the step table and the render kernels), kept as the reference
+    the golden renders are written from.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ProcessorDriver.h"
+
+//==============================================================================
+/** Renders the gate sample by sample from the processor's parameters, as
+    the first version of RhythmicGateAudioProcessor::processBlock did.
+    Only the float path exists, and the parameters are read once per block,
+    so the renders cannot use automation.
+*/
+class BaselineRender
+{
+public:
+    explicit BaselineRender(RhythmicGateAudioProcessor& p) : processor(p)
+    {
+        auto& apvts = processor.apvts;
+        metricParam = apvts.getRawParameterValue("METRIC");
+        attackParam = apvts.getRawParameterValue("ATTACK");
+        releaseParam = apvts.getRawParameterValue("RELEASE");
+        stepsParam = apvts.getRawParameterValue("STEPS");
+
+        for (int step = 0; step < RhythmicGateAudioProcessor::NUM_STEPS; ++step)
+        {
+            onOffParams[(size_t) step]    = apvts.getRawParameterValue(ParameterID::get(step, "ON"));
+            durationParams[(size_t) step] = apvts.getRawParameterValue(ParameterID::get(step, "DUR"));
+            levelParams[(size_t) step]    = apvts.getRawParameterValue(ParameterID::get(step, "LVL"));
+            auxSendParams[(size_t) step]  = apvts.getRawParameterValue(ParameterID::get(step, "AUX_LVL"));
+            panParams[(size_t) step]      = apvts.getRawParameterValue(ParameterID::get(step, "PAN"));
+        }
+    }
+
+    void prepare(double sampleRate)
+    {
+        currentSampleRate = sampleRate;
+        gateSmoother.reset(sampleRate, 0.0);
+        previousTargetGain = -1.0f;
+        internalPpq = 0.0;
+    }
+
+    /** Renders one block. The buffer holds the input in its first channels,
+        and receives the main bus then the aux bus. stepOfSample receives the
+        step playing at each sample.
+    */
+    void processBlock(juce::AudioBuffer<float>& buffer, const juce::AudioPlayHead& playHead, int* stepOfSample)
+    {
+        const int totalNumInputChannels = processor.getTotalNumInputChannels();
+
+        for (auto i = totalNumInputChannels; i < processor.getTotalNumOutputChannels(); ++i)
+            buffer.clear(i, 0, buffer.getNumSamples());
+
+        const auto optionalPositionInfo = playHead.getPosition();
+        if (! optionalPositionInfo.hasValue())
+        {
+            buffer.clear();
+            return;
+        }
+
+        const auto& positionInfo = *optionalPositionInfo;
+
+        // Calculate BPM (default to 120 if unavailable) and PPQ increment per sample
+        const auto bpmOpt = positionInfo.getBpm();
+        const double bpm = bpmOpt.hasValue() ? *bpmOpt : 120.0;
+        const double ppqPerSample = bpm / (currentSampleRate * 60.0);
+
+        // Determine the starting PPQ for this block
+        double currentBlockPpq = internalPpq;
+        if (positionInfo.getIsPlaying() && positionInfo.getPpqPosition().hasValue())
+            currentBlockPpq = *positionInfo.getPpqPosition();
+
+        internalPpq = currentBlockPpq + buffer.getNumSamples() * ppqPerSample;
+
+        auto mainOutputBuffer = processor.getBusBuffer(buffer, false, 0);
+        auto auxOutputBuffer  = processor.getBusBuffer(buffer, false, 1);
+
+        const int numSteps = static_cast<int>(stepsParam->load());
+        const float attackMs = attackParam->load();
+        const float releaseMs = releaseParam->load();
+
+        const int metricIndex = static_cast<int>(metricParam->load());
+        const auto& metrics = RhythmicGateAudioProcessor::getMetrics();
+        const double stepDurationInPpq = (metricIndex >= 0 && metricIndex < (int) metrics.size())
+                                       ? metrics[(size_t) metricIndex].duration
+                                       : 0.25;
+
+        const double sequenceDurationInPpq = numSteps * stepDurationInPpq;
+
+        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        {
+            const double currentPpq = currentBlockPpq + (sample * ppqPerSample);
+
+            // Find our position within the sequence
+            const double sequencePpq = fmod(currentPpq, sequenceDurationInPpq);
+            const int currentStep = juce::jlimit(0, numSteps - 1, static_cast<int>(sequencePpq / stepDurationInPpq));
+
+            // Calculate how far into the current step we are (0.0 to 1.0)
+            const double stepProgress = fmod(sequencePpq, stepDurationInPpq) / stepDurationInPpq;
+
+            const bool isOn = onOffParams[(size_t) currentStep]->load() > 0.5f;
+            const float duration = durationParams[(size_t) currentStep]->load();
+            const float mainLevel = juce::Decibels::decibelsToGain(levelParams[(size_t) currentStep]->load());
+            const float auxLevel = juce::Decibels::decibelsToGain(auxSendParams[(size_t) currentStep]->load());
+            const float pan = panParams[(size_t) currentStep]->load();
+
+            const float targetGain = (isOn && stepProgress < duration) ? 1.0f : 0.0f;
+
+            if (targetGain != previousTargetGain)
+            {
+                if (targetGain > previousTargetGain)
+                    gateSmoother.reset(currentSampleRate, attackMs / 1000.0); // Attack
+                else
+                    gateSmoother.reset(currentSampleRate, releaseMs / 1000.0); // Release
+
+                gateSmoother.setTargetValue(targetGain);
+                previousTargetGain = targetGain;
+            }
+
+            const float gain = gateSmoother.getNextValue();
+            const float panLeft = std::sqrt(0.5f * (1.0f - pan));
+            const float panRight = std::sqrt(0.5f * (1.0f + pan));
+
+            for (int channel = 0; channel < totalNumInputChannels; ++channel)
+            {
+                const float inputSample = buffer.getSample(channel, sample);
+                const float panGain = (channel == 0) ? panLeft : panRight;
+
+                mainOutputBuffer.setSample(channel, sample, inputSample * gain * mainLevel * panGain);
+                auxOutputBuffer.setSample(channel, sample, inputSample * gain * auxLevel * panGain);
+            }
+
+            stepOfSample[sample] = currentStep;
+        }
+    }
+
+private:
+    RhythmicGateAudioProcessor& processor;
+
+    std::atomic<float>* metricParam = nullptr;
+    std::atomic<float>* attackParam = nullptr;
+    std::atomic<float>* releaseParam = nullptr;
+    std::atomic<float>* stepsParam = nullptr;
+    std::array<std::atomic<float>*, RhythmicGateAudioProcessor::NUM_STEPS> onOffParams {};
+    std::array<std::atomic<float>*, RhythmicGateAudioProcessor::NUM_STEPS> durationParams {};
+    std::array<std::atomic<float>*, RhythmicGateAudioProcessor::NUM_STEPS> levelParams {};
+    std::array<std::atomic<float>*, RhythmicGateAudioProcessor::NUM_STEPS> auxSendParams {};
+    std::array<std::atomic<float>*, RhythmicGateAudioProcessor::NUM_STEPS> panParams {};
+
+    double currentSampleRate = 44100.0;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> gateSmoother;
+    float previousTargetGain = -1.0f;
+    double internalPpq = 0.0;
+};
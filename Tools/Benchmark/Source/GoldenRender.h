@@ -0,0 +1,405 @@
+/*
+  ==============================================================================
+
+    GoldenRender.h
+    Created: 16 Oct 2026 3:47:26pm
+    Author:  doare
+
+    Golden-render comparison of the gate output.
+    A reference build writes the renders of a fixed matrix of patterns,
+    metrics, attack/release settings and transport scripts; a new build
+    renders the same matrix and compares against them, either bit-exact or
+    within a ULP / dB tolerance. Mismatches are reported per bus and per step.
+
+    The goldens can also be written from BaselineRender, the original
+    per-sample processBlock. It applies the step level and pan to the input
+    in another order than the render kernels, so a comparison against them
+    needs a few ULP of tolerance; the steps and the envelope match exactly.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ProcessorDriver.h"
+#include "BaselineRender.h"
+
+namespace GoldenRender
+{
+    /** Tolerance of the comparison. A sample matches if it is within maxUlp
+        units in the last place, or if its absolute error is below maxErrorDb.
+    */
+    struct Tolerance
+    {
+        int maxUlp = 0;
+        double maxErrorDb = -1000.0;
+    };
+
+    /** A render of every output bus, with the step playing at each sample. */
+    struct Render
+    {
+        juce::AudioBuffer<float> audio;
+        std::vector<int> stepOfSample;
+        juce::StringArray busNames;
+        std::vector<int> busOfChannel;
+    };
+
+    //==============================================================================
+    inline std::vector<RenderConfig> getCases()
+    {
+        static constexpr int metrics[] { 3, 7, 9, 14, 16 };  // 1/4, 1/8 T, 1/16, 1/32 D, 1/64 T
+        static constexpr int stepCounts[] { 16, 7, 12 };
+        static constexpr float attackRelease[][2] { { 0.0f, 5.0f }, { 10.0f, 50.0f }, { 100.0f, 0.0f } };
+
+        std::vector<RenderConfig> cases;
+
+        for (int script = 0; script < ScriptedPlayHead::getScriptNames().size(); ++script)
+        {
+            for (int m = 0; m < (int) std::size(metrics); ++m)
+            {
+                const int index = (int) cases.size();
+
+                RenderConfig config;
+                config.sampleRate = 44100.0;
+                config.blockSize = 512;
+                config.seconds = 0.5;
+                config.script = (ScriptedPlayHead::Script) script;
+                config.metricIndex = metrics[m];
+                config.numSteps = stepCounts[index % (int) std::size(stepCounts)];
+                config.attackMs = attackRelease[index % (int) std::size(attackRelease)][0];
+                config.releaseMs = attackRelease[index % (int) std::size(attackRelease)][1];
+                config.patternSeed = index + 1;
+                cases.push_back(config);
+            }
+        }
+
+        return cases;
+    }
+
+    inline Render render(const RenderConfig& config)
+    {
+        ProcessorDriver driver(config);
+        auto& processor = driver.getProcessor();
+
+        Render result;
+        const int numBlocks = driver.getTotalNumBlocks();
+        const int numSamples = numBlocks * config.blockSize;
+
+        for (int bus = 0; bus < processor.getBusCount(false); ++bus)
+        {
+            result.busNames.add(processor.getBus(false, bus)->getName());
+            for (int channel = 0; channel < processor.getBus(false, bus)->getNumberOfChannels(); ++channel)
+                result.busOfChannel.push_back(bus);
+        }
+
+        result.audio.setSize((int) result.busOfChannel.size(), numSamples);
+        result.stepOfSample.resize((size_t) numSamples);
+
+        GateScheduler scheduler;
+        scheduler.setTiming(RhythmicGateAudioProcessor::getMetrics()[(size_t) config.metricIndex].duration, config.numSteps);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const int offset = block * config.blockSize;
+            const double blockPpq = driver.getPlayHead().getGatePpqForNextBlock();
+            const double ppqPerSample = driver.getPlayHead().getBpm() / (config.sampleRate * 60.0);
+
+            for (int i = 0; i < config.blockSize; ++i)
+                result.stepOfSample[(size_t) (offset + i)] = scheduler.getStepAt(blockPpq + i * ppqPerSample);
+
+            driver.fillInput(block);
+            driver.processBlock();
+            const auto& buffer = driver.getOutput();
+
+            for (int channel = 0; channel < result.audio.getNumChannels(); ++channel)
+                result.audio.copyFrom(channel, offset, buffer, channel, 0, config.blockSize);
+        }
+
+        return result;
+    }
+
+    /** Renders a case with BaselineRender instead of the processor. */
+    inline Render renderBaseline(const RenderConfig& config)
+    {
+        jassert(! config.automation && ! config.doublePrecision);
+
+        ProcessorDriver driver(config);
+        auto& processor = driver.getProcessor();
+
+        BaselineRender baseline(processor);
+        baseline.prepare(config.sampleRate);
+
+        Render result;
+        const int numBlocks = driver.getTotalNumBlocks();
+        const int numSamples = numBlocks * config.blockSize;
+
+        for (int bus = 0; bus < processor.getBusCount(false); ++bus)
+        {
+            result.busNames.add(processor.getBus(false, bus)->getName());
+            for (int channel = 0; channel < processor.getBus(false, bus)->getNumberOfChannels(); ++channel)
+                result.busOfChannel.push_back(bus);
+        }
+
+        result.audio.setSize((int) result.busOfChannel.size(), numSamples);
+        result.stepOfSample.resize((size_t) numSamples);
+
+        const int numChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+        juce::AudioBuffer<float> buffer(numChannels, config.blockSize);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const int offset = block * config.blockSize;
+
+            driver.fillInput(block);
+            const auto& input = driver.getInput();
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                if (channel < input.getNumChannels())
+                    buffer.copyFrom(channel, 0, input, channel, 0, config.blockSize);
+                else
+                    buffer.clear(channel, 0, config.blockSize);
+            }
+
+            baseline.processBlock(buffer, driver.getPlayHead(), result.stepOfSample.data() + offset);
+            driver.skipBlock();
+
+            for (int channel = 0; channel < result.audio.getNumChannels(); ++channel)
+                result.audio.copyFrom(channel, offset, buffer, channel, 0, config.blockSize);
+        }
+
+        return result;
+    }
+
+    //==============================================================================
+    static constexpr int fileMagic = 0x444c4752; // "RGLD"
+    static constexpr int fileVersion = 1;
+
+    inline bool write(const juce::File& file, const juce::AudioBuffer<float>& audio)
+    {
+        file.deleteFile();
+        auto fileStream = file.createOutputStream();
+        if (fileStream == nullptr)
+            return false;
+
+        {
+            juce::GZIPCompressorOutputStream stream(*fileStream, 9);
+
+            stream.writeInt(fileMagic);
+            stream.writeInt(fileVersion);
+            stream.writeInt(audio.getNumChannels());
+            stream.writeInt(audio.getNumSamples());
+
+            for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+                for (int i = 0; i < audio.getNumSamples(); ++i)
+                    stream.writeFloat(audio.getSample(channel, i));
+        }
+
+        fileStream->flush();
+        return fileStream->getStatus().wasOk();
+    }
+
+    inline bool read(const juce::File& file, juce::AudioBuffer<float>& audio)
+    {
+        auto fileStream = file.createInputStream();
+        if (fileStream == nullptr)
+            return false;
+
+        juce::GZIPDecompressorInputStream stream(*fileStream);
+
+        if (stream.readInt() != fileMagic || stream.readInt() != fileVersion)
+            return false;
+
+        const int numChannels = stream.readInt();
+        const int numSamples = stream.readInt();
+        if (numChannels <= 0 || numSamples <= 0)
+            return false;
+
+        audio.setSize(numChannels, numSamples);
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                audio.setSample(channel, i, stream.readFloat());
+
+        return true;
+    }
+
+    //==============================================================================
+    /** Distance between two floats in units in the last place. */
+    inline juce::int64 getUlpDistance(float a, float b)
+    {
+        auto toOrdered = [] (float f)
+        {
+            juce::int32 bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            return bits < 0 ? (juce::int64) std::numeric_limits<juce::int32>::min() - bits : (juce::int64) bits;
+        };
+
+        return std::abs(toOrdered(a) - toOrdered(b));
+    }
+
+    /** Compares a render against its golden, prints the mismatches per bus and
+        per step, and returns the number of mismatching samples.
+    */
+    inline int compare(const Render& render, const juce::AudioBuffer<float>& golden, const Tolerance& tolerance)
+    {
+        if (golden.getNumChannels() != render.audio.getNumChannels()
+            || golden.getNumSamples() != render.audio.getNumSamples())
+        {
+            std::cout << "    layout mismatch: golden has " << golden.getNumChannels() << " channels x "
+                      << golden.getNumSamples() << " samples" << std::endl;
+            return juce::jmax(1, render.audio.getNumSamples());
+        }
+
+        const float maxError = juce::Decibels::decibelsToGain((float) tolerance.maxErrorDb, -1000.0f);
+        const int numSteps = RhythmicGateAudioProcessor::NUM_STEPS;
+
+        // Mismatch count and largest error, per bus and per step
+        const auto numBuses = (size_t) render.busNames.size();
+        std::vector<int> counts(numBuses * numSteps, 0);
+        std::vector<float> errors(numBuses * numSteps, 0.0f);
+        int total = 0;
+
+        for (int channel = 0; channel < golden.getNumChannels(); ++channel)
+        {
+            const auto bus = (size_t) render.busOfChannel[(size_t) channel];
+
+            for (int i = 0; i < golden.getNumSamples(); ++i)
+            {
+                const float expected = golden.getSample(channel, i);
+                const float actual = render.audio.getSample(channel, i);
+                const float error = std::abs(actual - expected);
+
+                if (getUlpDistance(actual, expected) <= tolerance.maxUlp || error <= maxError)
+                    continue;
+
+                const auto index = bus * numSteps + (size_t) render.stepOfSample[(size_t) i];
+                ++counts[index];
+                errors[index] = juce::jmax(errors[index], error);
+                ++total;
+            }
+        }
+
+        for (size_t bus = 0; bus < numBuses; ++bus)
+            for (int step = 0; step < numSteps; ++step)
+                if (const auto index = bus * numSteps + (size_t) step; counts[index] > 0)
+                    std::cout << "    " << render.busNames[(int) bus] << " step " << (step + 1) << ": "
+                              << counts[index] << " samples differ, max error "
+                              << juce::String(juce::Decibels::gainToDecibels(errors[index], -1000.0f), 1) << " dB" << std::endl;
+
+        return total;
+    }
+
+    //==============================================================================
+    /** Writes (shouldWrite) or compares the golden renders in the given folder.
+        fromBaseline writes them from BaselineRender instead of this build.
+        Returns the process exit code.
+    */
+    inline int run(const juce::File& folder, bool shouldWrite, bool fromBaseline, const Tolerance& tolerance)
+    {
+        if (shouldWrite && ! folder.createDirectory().wasOk())
+        {
+            std::cout << "Cannot create " << folder.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        int numFailed = 0;
+        const auto cases = getCases();
+
+        for (size_t i = 0; i < cases.size(); ++i)
+        {
+            const auto file = folder.getChildFile("case_" + juce::String((int) i).paddedLeft('0', 3) + ".rgold");
+            const auto result = shouldWrite && fromBaseline ? renderBaseline(cases[i]) : render(cases[i]);
+
+            std::cout << cases[i].getDescription().paddedRight(' ', 48);
+
+            if (shouldWrite)
+            {
+                const bool ok = write(file, result.audio);
+                std::cout << (ok ? "written" : "WRITE FAILED") << std::endl;
+                numFailed += ok ? 0 : 1;
+                continue;
+            }
+
+            juce::AudioBuffer<float> golden;
+            if (! file.existsAsFile() || ! read(file, golden))
+            {
+                std::cout << "MISSING GOLDEN" << std::endl;
+                ++numFailed;
+                continue;
+            }
+
+            std::cout << std::endl;
+            if (const int mismatches = compare(result, golden, tolerance); mismatches > 0)
+            {
+                std::cout << "    FAILED (" << mismatches << " samples)" << std::endl;
+                ++numFailed;
+            }
+        }
+
+        std::cout << (cases.size() - (size_t) numFailed) << "/" << cases.size() << " cases passed" << std::endl;
+        return numFailed == 0 ? 0 : 1;
+    }
+
+    //==============================================================================
+    /** Renders the same automated sessions at several block sizes, and checks
+        them against the render with the largest block size.
+
+        The sample positions are computed from the start of each block, so
+        their rounding depends on where the blocks start; a step boundary or
+        a duration cut-off falling exactly on a sample could then land on
+        either side of it. The sessions run at the tempo at which a sample
+        lasts 2^-15 PPQ: every position is exact in binary whatever the block
+        size, and the renders must null bit-exactly. At other tempi such a
+        boundary may move the gate by one sample.
+        Returns the process exit code.
+    */
+    inline int runNullTest(const Tolerance& tolerance)
+    {
+        static constexpr int blockSizes[] { 4096, 1, 32, 441, 512 };
+
+        int numCases = 0;
+        int numFailed = 0;
+
+        for (auto script : { ScriptedPlayHead::Script::playing, ScriptedPlayHead::Script::stopped })
+        {
+            RenderConfig config;
+            config.sampleRate = 44100.0;
+            config.bpm = config.sampleRate * 60.0 / 32768.0; // About 80.75 bpm
+            config.seconds = 0.5;
+            config.script = script;
+            config.attackMs = 2.0f;
+            config.releaseMs = 20.0f;
+            config.automation = true;
+            config.blockSize = blockSizes[0];
+
+            const auto reference = render(config);
+
+            for (size_t i = 1; i < std::size(blockSizes); ++i)
+            {
+                config.blockSize = blockSizes[i];
+                auto result = render(config);
+
+                // The renders only differ in length, by their last block
+                const int numSamples = juce::jmin(reference.audio.getNumSamples(), result.audio.getNumSamples());
+                result.audio.setSize(result.audio.getNumChannels(), numSamples, true);
+                result.stepOfSample.resize((size_t) numSamples);
+
+                juce::AudioBuffer<float> expected(reference.audio.getNumChannels(), numSamples);
+                for (int channel = 0; channel < expected.getNumChannels(); ++channel)
+                    expected.copyFrom(channel, 0, reference.audio, channel, 0, numSamples);
+
+                std::cout << config.getDescription().paddedRight(' ', 48) << std::endl;
+                if (const int mismatches = compare(result, expected, tolerance); mismatches > 0)
+                {
+                    std::cout << "    FAILED (" << mismatches << " samples)" << std::endl;
+                    ++numFailed;
+                }
+
+                ++numCases;
+            }
+        }
+
+        std::cout << (numCases - numFailed) << "/" << numCases << " block sizes null" << std::endl;
+        return numFailed == 0 ? 0 : 1;
+    }
+}
@@ -0,0 +1,510 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 16 Oct 2026 2:31:44pm
+    Author:  doare
+
+    Headless benchmark of RhythmicGateAudioProcessor::processBlock.
+
+    Usage: RhyGaBenchmark [--full] [--seconds <s>] [--double]
+           RhyGaBenchmark --write-golden <folder> [--baseline]
+           RhyGaBenchmark --compare-golden <folder> [--ulp <n>] [--db <dBFS>]
+           RhyGaBenchmark --null-test [--ulp <n>] [--db <dBFS>]
+           RhyGaBenchmark --offline [--seconds <s>]
+           RhyGaBenchmark --state [--instances <n>]
+           RhyGaBenchmark --rt-audit [--seconds <s>]
+           RhyGaBenchmark --trace <file> [--seconds <s>]
+           RhyGaBenchmark --editor [--instances <n>]
+
+    By default each dimension (block size, sample rate, metric, step count,
+    transport script) is swept while the others keep their default value.
+    --full runs the cartesian product of all dimensions instead.
+    --double processes in double precision, as a 64-bit host would.
+
+    --write-golden renders the golden-render matrix with this build, or with
+    the original per-sample gate (see BaselineRender.h) with --baseline, and
+    --compare-golden checks this build against renders written by another
+    one. The comparison is bit-exact unless a tolerance in ULP, or an
+    absolute error floor in dBFS, is given; goldens written with --baseline
+    need --ulp 4.
+
+    --null-test renders sample-accurate automation at several block sizes,
+    and checks that the renders null against each other, at a tempo where
+    every sample position is exact in binary (see GoldenRender::runNullTest).
+
+    --offline times OfflineGateRenderer on one long buffer, rendered in one
+    piece and then in chunks on thread pools of increasing size, and checks
+    that the chunked renders match the single-piece one exactly.
+
+    --state compares the size and the load time of the binary state with
+    the XML state of older versions, over as many instances as a large
+    session holds, and checks that the binary state round-trips.
+
+    --rt-audit runs processBlock through every transport script, with host
+    automation and bulk pattern edits between the blocks, and fails on any
+    allocation, lock or blocking call made from it (see RealtimeAudit.h).
+    It needs the RealtimeAudit configuration of the project.
+
+    --trace runs every transport script and writes the trace events of the
+    processor to a Chrome trace-event JSON file. It needs a build defining
+    RHYGA_ENABLE_TRACING=1.
+
+    --editor times the construction of as many editors as a large session
+    opens, counts their components, and times a full repaint of an editor.
+    Run it on two builds to compare their editors.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ProcessorDriver.h"
+#include "GoldenRender.h"
+#include "RealtimeAudit.h"
+#include "../../../Source/OfflineGateRenderer.h"
+
+//==============================================================================
+struct BenchmarkResult
+{
+    double nsPerSample;
+    double p50Us;
+    double p99Us;
+    double maxUs;
+    float p99Load; // As reported by the processor's own meter
+};
+
+static BenchmarkResult runBenchmark(const RenderConfig& config)
+{
+    ProcessorDriver driver(config);
+
+    const int numBlocks = driver.getTotalNumBlocks();
+    std::vector<double> blockTimes((size_t) numBlocks);
+    double totalSeconds = 0.0;
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        driver.fillInput(block);
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        driver.processBlock();
+        const auto end = juce::Time::getHighResolutionTicks();
+
+        blockTimes[(size_t) block] = juce::Time::highResolutionTicksToSeconds(end - start);
+        totalSeconds += blockTimes[(size_t) block];
+    }
+
+    std::sort(blockTimes.begin(), blockTimes.end());
+
+    auto percentile = [&blockTimes] (double p)
+    {
+        const auto index = (size_t) juce::jlimit(0, (int) blockTimes.size() - 1, (int) std::ceil(p * (double) blockTimes.size()) - 1);
+        return blockTimes[index] * 1.0e6;
+    };
+
+    return { totalSeconds * 1.0e9 / ((double) numBlocks * config.blockSize),
+             percentile(0.5),
+             percentile(0.99),
+             blockTimes.back() * 1.0e6,
+             ProcessLoadMeter::getStats(driver.getProcessor().getLoadMeter().getSnapshot()).p99Load };
+}
+
+static void printResult(const RenderConfig& config, const BenchmarkResult& result)
+{
+    std::cout << config.getDescription().paddedRight(' ', 48)
+              << juce::String(result.nsPerSample, 2).paddedLeft(' ', 10) << " ns/sample"
+              << "  p50 " << juce::String(result.p50Us, 2).paddedLeft(' ', 9) << " us"
+              << "  p99 " << juce::String(result.p99Us, 2).paddedLeft(' ', 9) << " us"
+              << "  max " << juce::String(result.maxUs, 2).paddedLeft(' ', 9) << " us"
+              << "  load p99 " << juce::String(result.p99Load, 2).paddedLeft(' ', 7) << " %"
+              << std::endl;
+}
+
+//==============================================================================
+static int runOfflineBenchmark(const RenderConfig& config)
+{
+    ProcessorDriver driver(config);
+    auto& processor = driver.getProcessor();
+    const auto channelSet = processor.getChannelLayoutOfBus(true, 0);
+    const OfflineGateRenderer renderer(processor, channelSet, config.sampleRate, driver.getPlayHead().getBpm());
+
+    const int numSamples = juce::roundToInt(config.seconds * config.sampleRate);
+    juce::AudioBuffer<float> input(channelSet.size(), numSamples);
+    juce::Random random(1);
+    for (int channel = 0; channel < input.getNumChannels(); ++channel)
+        for (int i = 0; i < numSamples; ++i)
+            input.setSample(channel, i, random.nextFloat() - 0.5f);
+
+    juce::AudioBuffer<float> referenceMain(input.getNumChannels(), numSamples);
+    juce::AudioBuffer<float> referenceAux(input.getNumChannels(), numSamples);
+    juce::AudioBuffer<float> mainOutput(input.getNumChannels(), numSamples);
+    juce::AudioBuffer<float> auxOutput(input.getNumChannels(), numSamples);
+
+    auto printTime = [numSamples] (const juce::String& name, juce::int64 start, juce::int64 end)
+    {
+        const auto seconds = juce::Time::highResolutionTicksToSeconds(end - start);
+        std::cout << name.paddedRight(' ', 24)
+                  << juce::String(seconds * 1.0e9 / numSamples, 3).paddedLeft(' ', 10) << " ns/sample"
+                  << juce::String(seconds * 1.0e3, 1).paddedLeft(' ', 10) << " ms";
+    };
+
+    auto isSame = [numSamples] (const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            if (std::memcmp(a.getReadPointer(channel), b.getReadPointer(channel), sizeof(float) * (size_t) numSamples) != 0)
+                return false;
+
+        return true;
+    };
+
+    std::cout << config.getDescription() << ", " << config.seconds << " s" << std::endl;
+
+    auto start = juce::Time::getHighResolutionTicks();
+    renderer.render(input, referenceMain, referenceAux, 0);
+    printTime("single piece", start, juce::Time::getHighResolutionTicks());
+    std::cout << std::endl;
+
+    int numFailed = 0;
+
+    for (int numThreads = 1; numThreads <= juce::SystemStats::getNumCpus(); numThreads *= 2)
+    {
+        juce::ThreadPool pool(numThreads);
+        mainOutput.clear();
+        auxOutput.clear();
+
+        start = juce::Time::getHighResolutionTicks();
+        renderer.renderParallel(input, mainOutput, auxOutput, 0, pool);
+        printTime(juce::String(numThreads) + " threads", start, juce::Time::getHighResolutionTicks());
+
+        const bool ok = isSame(mainOutput, referenceMain) && isSame(auxOutput, referenceAux);
+        std::cout << (ok ? "  seamless" : "  MISMATCH") << std::endl;
+        numFailed += ok ? 0 : 1;
+    }
+
+    return numFailed == 0 ? 0 : 1;
+}
+
+//==============================================================================
+static int runStateBenchmark(int numInstances)
+{
+    // One random pattern per instance, as in a session
+    std::vector<std::unique_ptr<RhythmicGateAudioProcessor>> sources, targets;
+    juce::Random random(1);
+    for (int i = 0; i < numInstances; ++i)
+    {
+        sources.push_back(std::make_unique<RhythmicGateAudioProcessor>());
+        targets.push_back(std::make_unique<RhythmicGateAudioProcessor>());
+
+        RhythmicGateAudioProcessor::PatternEdit edit(*sources.back());
+        for (auto* param : sources.back()->getRandomizableParameters())
+            edit.set(param, random.nextFloat());
+    }
+
+    std::vector<juce::MemoryBlock> binaryStates((size_t) numInstances), xmlStates((size_t) numInstances);
+    size_t binarySize = 0, xmlSize = 0;
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        sources[i]->getStateInformation(binaryStates[i]);
+        std::unique_ptr<juce::XmlElement> xml(sources[i]->apvts.copyState().createXml());
+        juce::AudioProcessor::copyXmlToBinary(*xml, xmlStates[i]);
+        binarySize += binaryStates[i].getSize();
+        xmlSize += xmlStates[i].getSize();
+    }
+
+    std::cout << numInstances << " instances" << std::endl
+              << "state size: binary " << binarySize / sources.size() << " bytes, XML "
+              << xmlSize / sources.size() << " bytes" << std::endl;
+
+    // Each round, every instance loads the pattern of another one, so that
+    // all its parameters change
+    constexpr int numRounds = 8;
+    auto timeLoad = [&] (const juce::String& name, std::function<void(RhythmicGateAudioProcessor&, const juce::MemoryBlock&)> load,
+                         const std::vector<juce::MemoryBlock>& states)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int round = 1; round <= numRounds; ++round)
+            for (size_t i = 0; i < targets.size(); ++i)
+                load(*targets[i], states[(i + (size_t) round) % states.size()]);
+        const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        std::cout << name.paddedRight(' ', 24)
+                  << juce::String(seconds * 1.0e3 / numRounds, 2).paddedLeft(' ', 10) << " ms per session"
+                  << juce::String(seconds * 1.0e6 / (numRounds * numInstances), 1).paddedLeft(' ', 10) << " us per instance"
+                  << std::endl;
+    };
+
+    auto setState = [] (RhythmicGateAudioProcessor& processor, const juce::MemoryBlock& state)
+    {
+        processor.setStateInformation(state.getData(), (int) state.getSize());
+    };
+
+    timeLoad("XML, replaceState", [] (RhythmicGateAudioProcessor& processor, const juce::MemoryBlock& state)
+    {
+        // The loading of older versions
+        if (auto xml = juce::AudioProcessor::getXmlFromBinary(state.getData(), (int) state.getSize()))
+            processor.apvts.replaceState(juce::ValueTree::fromXml(*xml));
+    }, xmlStates);
+    timeLoad("XML, one pass", setState, xmlStates);
+    timeLoad("binary, one pass", setState, binaryStates);
+
+    // Both formats restore the same pattern, and the binary state round-trips
+    int numFailed = 0;
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        juce::MemoryBlock fromBinary, fromXml;
+        setState(*targets[i], binaryStates[i]);
+        targets[i]->getStateInformation(fromBinary);
+        setState(*targets[i], xmlStates[i]);
+        targets[i]->getStateInformation(fromXml);
+        numFailed += (fromBinary == binaryStates[i] && fromXml == binaryStates[i]) ? 0 : 1;
+    }
+
+    std::cout << (numFailed == 0 ? "round trip ok" : juce::String(numFailed) + " states differ after loading") << std::endl;
+    return numFailed == 0 ? 0 : 1;
+}
+
+//==============================================================================
+static int countComponents(const juce::Component& component)
+{
+    int numComponents = 1;
+    for (auto* child : component.getChildren())
+        numComponents += countComponents(*child);
+
+    return numComponents;
+}
+
+static int runEditorBenchmark(int numInstances)
+{
+    std::vector<std::unique_ptr<RhythmicGateAudioProcessor>> processors;
+    for (int i = 0; i < numInstances; ++i)
+        processors.push_back(std::make_unique<RhythmicGateAudioProcessor>());
+
+    std::vector<std::unique_ptr<juce::AudioProcessorEditor>> editors;
+    const auto start = juce::Time::getHighResolutionTicks();
+    for (auto& processor : processors)
+        editors.emplace_back(processor->createEditor());
+    const auto constructionSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+    auto& editor = *editors.front();
+    std::cout << numInstances << " editors" << std::endl
+              << "components per editor   " << countComponents(editor) << std::endl
+              << "construction            " << juce::String(constructionSeconds * 1.0e3 / numInstances, 3).paddedLeft(' ', 10)
+              << " ms per editor" << std::endl;
+
+    // Full repaints, as when the host window is exposed
+    constexpr int numFrames = 200;
+    juce::Image image(juce::Image::ARGB, editor.getWidth(), editor.getHeight(), true);
+    const auto paintStart = juce::Time::getHighResolutionTicks();
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        juce::Graphics g(image);
+        editor.paintEntireComponent(g, false);
+    }
+    const auto paintSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - paintStart);
+
+    std::cout << "full repaint            " << juce::String(paintSeconds * 1.0e3 / numFrames, 3).paddedLeft(' ', 10)
+              << " ms per frame" << std::endl;
+
+    const auto destructionStart = juce::Time::getHighResolutionTicks();
+    editors.clear();
+    const auto destructionSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - destructionStart);
+
+    std::cout << "destruction             " << juce::String(destructionSeconds * 1.0e3 / numInstances, 3).paddedLeft(' ', 10)
+              << " ms per editor" << std::endl;
+    return 0;
+}
+
+//==============================================================================
+static int runRealtimeAudit(const RenderConfig& defaults)
+{
+    if (! RealtimeAudit::isAvailable())
+    {
+        std::cout << "Build the RealtimeAudit configuration (RHYGA_RT_AUDIT=1) to audit processBlock" << std::endl;
+        return 1;
+    }
+
+    RealtimeAudit::initialise();
+
+    for (int script = 0; script < ScriptedPlayHead::getScriptNames().size(); ++script)
+    {
+        for (auto blockSize : { 32, 512 })
+        {
+            for (auto doublePrecision : { false, true })
+            {
+                auto config = defaults;
+                config.script = (ScriptedPlayHead::Script) script;
+                config.blockSize = blockSize;
+                config.doublePrecision = doublePrecision;
+                config.automation = true;
+                config.realtimeAudit = true;
+
+                ProcessorDriver driver(config);
+                auto& processor = driver.getProcessor();
+                juce::Random random(config.patternSeed);
+                const int numViolationsBefore = RealtimeAudit::getNumViolations();
+
+                for (int block = 0; block < driver.getTotalNumBlocks(); ++block)
+                {
+                    // Bulk randomization and metric changes, as the editor does them
+                    if (block % 16 == 0)
+                    {
+                        RhythmicGateAudioProcessor::PatternEdit edit(processor);
+                        edit.randomize(random);
+                    }
+
+                    if (block % 64 == 32)
+                        driver.setParameter("METRIC", (float) random.nextInt((int) RhythmicGateAudioProcessor::getMetrics().size()));
+
+                    driver.fillInput(block);
+                    driver.processBlock();
+                }
+
+                const int numViolations = RealtimeAudit::getNumViolations() - numViolationsBefore;
+                std::cout << config.getDescription().paddedRight(' ', 56)
+                          << (numViolations == 0 ? juce::String("ok") : juce::String(numViolations) + " violations") << std::endl;
+            }
+        }
+    }
+
+    return RealtimeAudit::getNumViolations() == 0 ? 0 : 1;
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    auto getOption = [&args] (const juce::String& name) -> juce::String
+    {
+        const int index = args.indexOf(name);
+        return index >= 0 && index + 1 < args.size() ? args[index + 1] : juce::String();
+    };
+
+    GoldenRender::Tolerance tolerance;
+    if (args.contains("--ulp"))
+        tolerance.maxUlp = getOption("--ulp").getIntValue();
+    if (args.contains("--db"))
+        tolerance.maxErrorDb = getOption("--db").getDoubleValue();
+
+    if (args.contains("--write-golden") || args.contains("--compare-golden"))
+    {
+        const bool shouldWrite = args.contains("--write-golden");
+        const auto folder = juce::File::getCurrentWorkingDirectory()
+                                .getChildFile(getOption(shouldWrite ? "--write-golden" : "--compare-golden"));
+
+        return GoldenRender::run(folder, shouldWrite, args.contains("--baseline"), tolerance);
+    }
+
+    if (args.contains("--null-test"))
+        return GoldenRender::runNullTest(tolerance);
+
+    if (args.contains("--offline"))
+    {
+        RenderConfig config;
+        config.seconds = args.contains("--seconds") ? getOption("--seconds").getDoubleValue() : 60.0;
+        config.attackMs = 2.0f;
+        config.releaseMs = 20.0f;
+        return runOfflineBenchmark(config);
+    }
+
+    if (args.contains("--rt-audit"))
+    {
+        RenderConfig config;
+        if (args.contains("--seconds"))
+            config.seconds = getOption("--seconds").getDoubleValue();
+        return runRealtimeAudit(config);
+    }
+
+    if (args.contains("--trace"))
+    {
+       #if RHYGA_ENABLE_TRACING
+        RenderConfig config;
+        if (args.contains("--seconds"))
+            config.seconds = getOption("--seconds").getDoubleValue();
+
+        for (int script = 0; script < ScriptedPlayHead::getScriptNames().size(); ++script)
+        {
+            config.script = (ScriptedPlayHead::Script) script;
+            printResult(config, runBenchmark(config));
+        }
+
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(getOption("--trace"));
+        const bool written = TraceEvents::writeChromeTrace(file);
+        std::cout << (written ? "Trace written to " : "Cannot write ") << file.getFullPathName() << std::endl;
+        return written ? 0 : 1;
+       #else
+        std::cout << "Build with RHYGA_ENABLE_TRACING=1 to record trace events" << std::endl;
+        return 1;
+       #endif
+    }
+
+    if (args.contains("--state"))
+        return runStateBenchmark(args.contains("--instances") ? juce::jmax(1, getOption("--instances").getIntValue()) : 150);
+
+    if (args.contains("--editor"))
+        return runEditorBenchmark(args.contains("--instances") ? juce::jmax(1, getOption("--instances").getIntValue()) : 50);
+
+    const bool full = args.contains("--full");
+
+    RenderConfig defaults;
+    if (args.contains("--seconds"))
+        defaults.seconds = getOption("--seconds").getDoubleValue();
+    defaults.doublePrecision = args.contains("--double");
+
+    const std::vector<int> blockSizes { 1, 8, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192 };
+    const std::vector<double> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+
+    std::vector<int> metrics;
+    for (int i = 0; i < (int) RhythmicGateAudioProcessor::getMetrics().size(); ++i)
+        metrics.push_back(i);
+
+    std::vector<int> stepCounts;
+    for (int i = 2; i <= RhythmicGateAudioProcessor::NUM_STEPS; ++i)
+        stepCounts.push_back(i);
+
+    std::vector<ScriptedPlayHead::Script> scripts;
+    for (int i = 0; i < ScriptedPlayHead::getScriptNames().size(); ++i)
+        scripts.push_back((ScriptedPlayHead::Script) i);
+
+    auto run = [] (const RenderConfig& config) { printResult(config, runBenchmark(config)); };
+
+    if (full)
+    {
+        for (auto sampleRate : sampleRates)
+            for (auto blockSize : blockSizes)
+                for (auto metric : metrics)
+                    for (auto numSteps : stepCounts)
+                        for (auto script : scripts)
+                        {
+                            auto config = defaults;
+                            config.sampleRate = sampleRate;
+                            config.blockSize = blockSize;
+                            config.metricIndex = metric;
+                            config.numSteps = numSteps;
+                            config.script = script;
+                            run(config);
+                        }
+
+        return 0;
+    }
+
+    std::cout << "--- Block sizes" << std::endl;
+    for (auto blockSize : blockSizes)  { auto config = defaults; config.blockSize = blockSize;    run(config); }
+
+    std::cout << "--- Sample rates" << std::endl;
+    for (auto sampleRate : sampleRates) { auto config = defaults; config.sampleRate = sampleRate; run(config); }
+
+    std::cout << "--- Metrics" << std::endl;
+    for (auto metric : metrics)        { auto config = defaults; config.metricIndex = metric;     run(config); }
+
+    std::cout << "--- Step counts" << std::endl;
+    for (auto numSteps : stepCounts)   { auto config = defaults; config.numSteps = numSteps;      run(config); }
+
+    std::cout << "--- Transport scripts" << std::endl;
+    for (auto script : scripts)        { auto config = defaults; config.script = script;          run(config); }
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+    ProcessorDriver.h
+    Created: 16 Oct 2026 2:18:10pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "ScriptedPlayHead.h"
+#include "RealtimeAudit.h"
+
+//==============================================================================
+/** Settings of one headless render. */
+struct RenderConfig
+{
+    double sampleRate = 48000.0;
+    double bpm = 120.0; // Initial tempo of the script
+    int blockSize = 512;
+    int metricIndex = 9; // 1/16
+    int numSteps = RhythmicGateAudioProcessor::NUM_STEPS;
+    ScriptedPlayHead::Script script = ScriptedPlayHead::Script::playing;
+    double seconds = 2.0;
+    float attackMs = 0.0f;
+    float releaseMs = 5.0f;
+    int patternSeed = 1;
+    bool automation = false; // Sample-accurate automation of the levels, pans, durations, attack and release
+    bool doublePrecision = false;
+    bool realtimeAudit = false; // Audit processBlock for calls that are not real-time safe
+
+    juce::String getDescription() const
+    {
+        return juce::String(sampleRate / 1000.0, 1) + "k"
+             + " bs=" + juce::String(blockSize)
+             + " metric=" + RhythmicGateAudioProcessor::getMetrics()[(size_t) metricIndex].name
+             + " steps=" + juce::String(numSteps)
+             + " " + ScriptedPlayHead::getScriptNames()[(int) script]
+             + (bpm != 120.0 ? " bpm=" + juce::String(bpm, 2) : juce::String())
+             + (automation ? " automation" : "")
+             + (doublePrecision ? " double" : "");
+    }
+};
+
+//==============================================================================
+/** Creates a RhythmicGateAudioProcessor without an editor and drives it
+    block by block through a ScriptedPlayHead.
+*/
+class ProcessorDriver
+{
+public:
+    explicit ProcessorDriver(const RenderConfig& c)
+        : config(c), playHead(c.script, c.sampleRate, c.bpm)
+    {
+        setParameter("METRIC", (float) config.metricIndex);
+        setParameter("STEPS", (float) config.numSteps);
+        setParameter("ATTACK", config.attackMs);
+        setParameter("RELEASE", config.releaseMs);
+        setPattern(config.patternSeed);
+
+        if (config.automation)
+        {
+            automatedParams.add(processor.apvts.getParameter("ATTACK"));
+            automatedParams.add(processor.apvts.getParameter("RELEASE"));
+
+            for (int step = 0; step < RhythmicGateAudioProcessor::NUM_STEPS; ++step)
+                for (auto type : { "DUR", "LVL", "PAN" })
+                    automatedParams.add(processor.apvts.getParameter(ParameterID::get(step, type)));
+        }
+
+        processor.setPlayHead(&playHead);
+        processor.setProcessingPrecision(config.doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                                : juce::AudioProcessor::singlePrecision);
+        processor.setRateAndBufferSizeDetails(config.sampleRate, config.blockSize);
+        processor.prepareToPlay(config.sampleRate, config.blockSize);
+
+        // The buffer holds the channels of every bus, as a host would provide
+        const int numChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+        buffer.setSize(numChannels, config.blockSize);
+        input.setSize(processor.getTotalNumInputChannels(), config.blockSize);
+
+        if (config.doublePrecision)
+        {
+            doubleBuffer.setSize(numChannels, config.blockSize);
+            doubleInput.setSize(processor.getTotalNumInputChannels(), config.blockSize);
+        }
+    }
+
+    ~ProcessorDriver()
+    {
+        processor.releaseResources();
+    }
+
+    RhythmicGateAudioProcessor& getProcessor() noexcept { return processor; }
+    const RenderConfig& getConfig() const noexcept { return config; }
+    const ScriptedPlayHead& getPlayHead() const noexcept { return playHead; }
+
+    int getTotalNumBlocks() const noexcept
+    {
+        return juce::roundToInt(std::ceil(config.seconds * config.sampleRate / config.blockSize));
+    }
+
+    void setParameter(const juce::String& paramID, float value)
+    {
+        if (auto* param = processor.apvts.getParameter(paramID))
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
+
+    /** Sets a reproducible pseudo-random pattern on all steps. */
+    void setPattern(int seed)
+    {
+        juce::Random random(seed);
+
+        for (int step = 0; step < RhythmicGateAudioProcessor::NUM_STEPS; ++step)
+        {
+            setParameter(ParameterID::get(step, "ON"), random.nextFloat() < 0.7f ? 1.0f : 0.0f);
+            setParameter(ParameterID::get(step, "DUR"), random.nextFloat());
+            setParameter(ParameterID::get(step, "LVL"), -24.0f + 30.0f * random.nextFloat());
+            setParameter(ParameterID::get(step, "AUX_LVL"), -60.0f + 66.0f * random.nextFloat());
+            setParameter(ParameterID::get(step, "PAN"), -1.0f + 2.0f * random.nextFloat());
+        }
+    }
+
+    /** Fills the input channels of the next block with a reproducible signal. */
+    void fillInput(int blockIndex)
+    {
+        for (int channel = 0; channel < input.getNumChannels(); ++channel)
+        {
+            auto* data = input.getWritePointer(channel);
+
+            for (int i = 0; i < config.blockSize; ++i)
+            {
+                const auto n = (double) blockIndex * config.blockSize + i;
+                data[i] = (float) (0.5 * std::sin(juce::MathConstants<double>::twoPi * (220.0 + 110.0 * channel) * n / config.sampleRate));
+            }
+        }
+
+        if (config.doublePrecision)
+            doubleInput.makeCopyOf(input, true);
+    }
+
+    /** Processes one block of input, in the precision of the config. */
+    void processBlock()
+    {
+        if (config.automation)
+            queueAutomation();
+
+        if (config.doublePrecision)
+            processBlock(doubleBuffer, doubleInput);
+        else
+            processBlock(buffer, input);
+
+        skipBlock();
+    }
+
+    /** Moves the transport to the next block without processing, for a block
+        rendered by other means from getInput().
+    */
+    void skipBlock()
+    {
+        playHead.advance(config.blockSize);
+        samplePosition += config.blockSize;
+    }
+
+    const juce::AudioBuffer<float>& getInput() const noexcept { return input; }
+
+    /** Returns the buffer holding every bus after the last processed block. */
+    const juce::AudioBuffer<float>& getOutput()
+    {
+        if (config.doublePrecision)
+            buffer.makeCopyOf(doubleBuffer, true);
+
+        return buffer;
+    }
+
+    // Distance between two automation points, in samples
+    static constexpr int automationInterval = 311;
+
+private:
+    template <typename SampleType>
+    void processBlock(juce::AudioBuffer<SampleType>& block, const juce::AudioBuffer<SampleType>& blockInput)
+    {
+        for (int channel = 0; channel < block.getNumChannels(); ++channel)
+        {
+            if (channel < blockInput.getNumChannels())
+                block.copyFrom(channel, 0, blockInput, channel, 0, config.blockSize);
+            else
+                block.clear(channel, 0, config.blockSize);
+        }
+
+        // Only the processor's own work is audited, not the host's side above
+        const RealtimeAudit::ScopedAudit audit(config.realtimeAudit);
+        processor.processBlock(block, midi);
+    }
+
+    /** Queues the automation points that fall in the next block, and sets the
+        parameters to their value at the end of the block, as a host would.
+        The points only depend on their position on the timeline, not on the
+        block size.
+    */
+    void queueAutomation()
+    {
+        const auto firstPoint = (samplePosition + automationInterval - 1) / automationInterval * automationInterval;
+
+        for (auto position = firstPoint; position < samplePosition + config.blockSize; position += automationInterval)
+        {
+            juce::Random random(position);
+            auto* param = automatedParams[random.nextInt(automatedParams.size())];
+            const float value = random.nextFloat();
+
+            processor.queueParameterChange(param->getParameterIndex(), value, (int) (position - samplePosition));
+            param->setValueNotifyingHost(value);
+        }
+    }
+
+    RenderConfig config;
+    RhythmicGateAudioProcessor processor;
+    ScriptedPlayHead playHead;
+    juce::AudioBuffer<float> buffer;
+    juce::AudioBuffer<float> input;
+    juce::AudioBuffer<double> doubleBuffer;
+    juce::AudioBuffer<double> doubleInput;
+    juce::MidiBuffer midi;
+    juce::Array<juce::RangedAudioParameter*> automatedParams;
+    juce::int64 samplePosition = 0;
+};
@@ -0,0 +1,305 @@
+/*
+  ==============================================================================
+
+    RealtimeAudit.cpp
+    Created: 16 Oct 2026 8:24:51pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#include "RealtimeAudit.h"
+
+#ifndef RHYGA_RT_AUDIT
+ #define RHYGA_RT_AUDIT 0
+#endif
+
+#if RHYGA_RT_AUDIT && JUCE_LINUX
+ #include <cerrno>
+ #include <dlfcn.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <unistd.h>
+#endif
+
+namespace RealtimeAudit
+{
+    // Constant-initialised, so that the hooks can read them at any time
+    static thread_local bool isAuditing = false;
+    static thread_local bool isReporting = false;
+    static std::atomic<int> numViolations { 0 };
+
+    static void reportViolation(const char* functionName)
+    {
+        if (! isAuditing || isReporting)
+            return;
+
+        // What the report itself calls is not audited
+        isReporting = true;
+        ++numViolations;
+
+        static juce::CriticalSection reportLock;
+        static std::set<juce::String> reportedStacks;
+
+        {
+            const auto stack = juce::SystemStats::getStackBacktrace();
+            const juce::ScopedLock lock(reportLock);
+            if (reportedStacks.insert(functionName + stack).second)
+                std::cerr << "Real-time violation: " << functionName << " called from the audio thread" << std::endl
+                          << stack << std::endl;
+        } // The stack is freed here, still unaudited
+
+        isReporting = false;
+    }
+
+    bool isAvailable() noexcept { return RHYGA_RT_AUDIT != 0; }
+    int getNumViolations() noexcept { return numViolations.load(); }
+
+    ScopedAudit::ScopedAudit(bool shouldAudit) noexcept
+        : wasAuditing(isAuditing)
+    {
+        isAuditing = wasAuditing || shouldAudit;
+    }
+
+    ScopedAudit::~ScopedAudit() noexcept
+    {
+        isAuditing = wasAuditing;
+    }
+}
+
+#if RHYGA_RT_AUDIT
+//==============================================================================
+// Allocator. On Linux, malloc and friends are replaced too, since the
+// JUCE containers allocate with them; the replacements forward to glibc.
+#if JUCE_LINUX
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+extern "C" void __libc_free(void*);
+extern "C" void* __libc_memalign(size_t, size_t);
+
+extern "C" void* malloc(size_t size) noexcept
+{
+    RealtimeAudit::reportViolation("malloc");
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t numElements, size_t size) noexcept
+{
+    RealtimeAudit::reportViolation("calloc");
+    return __libc_calloc(numElements, size);
+}
+
+extern "C" void* realloc(void* pointer, size_t size) noexcept
+{
+    RealtimeAudit::reportViolation("realloc");
+    return __libc_realloc(pointer, size);
+}
+
+extern "C" void free(void* pointer) noexcept
+{
+    if (pointer != nullptr)
+        RealtimeAudit::reportViolation("free");
+    __libc_free(pointer);
+}
+
+extern "C" void* memalign(size_t alignment, size_t size) noexcept
+{
+    RealtimeAudit::reportViolation("memalign");
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" void* aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    RealtimeAudit::reportViolation("aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+{
+    RealtimeAudit::reportViolation("posix_memalign");
+
+    if (alignment % sizeof(void*) != 0 || ! juce::isPowerOfTwo(alignment))
+        return EINVAL;
+
+    auto* pointer = __libc_memalign(alignment, size);
+    if (pointer == nullptr)
+        return ENOMEM;
+
+    *result = pointer;
+    return 0;
+}
+
+static void* allocate(std::size_t size) noexcept  { return __libc_malloc(size); }
+static void release(void* pointer) noexcept       { __libc_free(pointer); }
+
+static void* allocateAligned(std::size_t size, std::size_t alignment) noexcept  { return __libc_memalign(alignment, size); }
+static void releaseAligned(void* pointer) noexcept                            { __libc_free(pointer); }
+#elif JUCE_WINDOWS
+static void* allocate(std::size_t size) noexcept  { return std::malloc(size); }
+static void release(void* pointer) noexcept       { std::free(pointer); }
+
+static void* allocateAligned(std::size_t size, std::size_t alignment) noexcept  { return _aligned_malloc(size, alignment); }
+static void releaseAligned(void* pointer) noexcept                            { _aligned_free(pointer); }
+#else
+static void* allocate(std::size_t size) noexcept  { return std::malloc(size); }
+static void release(void* pointer) noexcept       { std::free(pointer); }
+
+static void* allocateAligned(std::size_t size, std::size_t alignment) noexcept
+{
+    void* pointer = nullptr;
+    return posix_memalign(&pointer, juce::jmax(alignment, sizeof(void*)), size) == 0 ? pointer : nullptr;
+}
+
+static void releaseAligned(void* pointer) noexcept  { std::free(pointer); }
+#endif
+
+void* operator new(std::size_t size)
+{
+    RealtimeAudit::reportViolation("operator new");
+    if (auto* pointer = allocate(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    RealtimeAudit::reportViolation("operator new[]");
+    if (auto* pointer = allocate(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    RealtimeAudit::reportViolation("operator new");
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    RealtimeAudit::reportViolation("operator new[]");
+    return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer != nullptr)
+        RealtimeAudit::reportViolation("operator delete");
+    release(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    if (pointer != nullptr)
+        RealtimeAudit::reportViolation("operator delete[]");
+    release(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept    { operator delete(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept  { operator delete[](pointer); }
+
+// Over-aligned types (alignas beyond the default of new)
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    RealtimeAudit::reportViolation("operator new");
+    if (auto* pointer = allocateAligned(size, (std::size_t) alignment))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    RealtimeAudit::reportViolation("operator new[]");
+    if (auto* pointer = allocateAligned(size, (std::size_t) alignment))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    RealtimeAudit::reportViolation("operator new");
+    return allocateAligned(size, (std::size_t) alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    RealtimeAudit::reportViolation("operator new[]");
+    return allocateAligned(size, (std::size_t) alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    if (pointer != nullptr)
+        RealtimeAudit::reportViolation("operator delete");
+    releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    if (pointer != nullptr)
+        RealtimeAudit::reportViolation("operator delete[]");
+    releaseAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept    { operator delete(pointer, alignment); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept  { operator delete[](pointer, alignment); }
+void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept    { operator delete(pointer, alignment); }
+void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept  { operator delete[](pointer, alignment); }
+
+//==============================================================================
+// Locking and blocking calls (Linux only). Each replacement forwards to the
+// next definition of the function, found with dlsym on first use.
+#if JUCE_LINUX
+#define RHYGA_FOR_EACH_AUDITED_FUNCTION(X) \
+    X(int,     pthread_mutex_lock,     (pthread_mutex_t* m), (m), noexcept) \
+    X(int,     pthread_rwlock_rdlock,  (pthread_rwlock_t* l), (l), noexcept) \
+    X(int,     pthread_rwlock_wrlock,  (pthread_rwlock_t* l), (l), noexcept) \
+    X(int,     pthread_cond_wait,      (pthread_cond_t* c, pthread_mutex_t* m), (c, m), ) \
+    X(int,     pthread_cond_timedwait, (pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t), (c, m, t), ) \
+    X(int,     sem_wait,               (sem_t* s), (s), ) \
+    X(int,     sem_timedwait,          (sem_t* s, const struct timespec* t), (s, t), ) \
+    X(int,     nanosleep,              (const struct timespec* t, struct timespec* r), (t, r), ) \
+    X(int,     usleep,                 (useconds_t u), (u), ) \
+    X(ssize_t, read,                   (int f, void* b, size_t n), (f, b, n), ) \
+    X(ssize_t, write,                  (int f, const void* b, size_t n), (f, b, n), )
+
+// Not function-local statics: their initialisation guard could itself lock
+#define RHYGA_DECLARE_NEXT(returnType, name, params, args, exceptionSpec) \
+    static std::atomic<void*> next_##name { nullptr };
+
+RHYGA_FOR_EACH_AUDITED_FUNCTION(RHYGA_DECLARE_NEXT)
+
+static void* resolveNext(std::atomic<void*>& next, const char* name) noexcept
+{
+    auto* function = next.load(std::memory_order_relaxed);
+    if (function == nullptr)
+    {
+        function = dlsym(RTLD_NEXT, name);
+        next.store(function, std::memory_order_relaxed);
+    }
+
+    return function;
+}
+
+#define RHYGA_DEFINE_HOOK(returnType, name, params, args, exceptionSpec) \
+    extern "C" returnType name params exceptionSpec \
+    { \
+        RealtimeAudit::reportViolation(#name); \
+        return reinterpret_cast<returnType (*) params>(resolveNext(next_##name, #name)) args; \
+    }
+
+RHYGA_FOR_EACH_AUDITED_FUNCTION(RHYGA_DEFINE_HOOK)
+#endif
+
+void RealtimeAudit::initialise()
+{
+    // dlsym allocates: resolve everything before auditing starts
+   #if JUCE_LINUX
+    #define RHYGA_RESOLVE_NEXT(returnType, name, params, args, exceptionSpec) resolveNext(next_##name, #name);
+    RHYGA_FOR_EACH_AUDITED_FUNCTION(RHYGA_RESOLVE_NEXT)
+   #endif
+}
+#else
+void RealtimeAudit::initialise() {}
+#endif
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    RealtimeAudit.h
+    Created: 16 Oct 2026 8:24:51pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Detects the calls that are not real-time safe made from processBlock.
+
+    In builds defining RHYGA_RT_AUDIT=1 (the RealtimeAudit configuration of
+    RhyGaBenchmark.jucer), the allocator is hooked and, on Linux, so are the
+    locking and blocking entry points (mutexes, condition variables,
+    semaphores, sleeps, file reads and writes). Any of them reached on a
+    thread inside a ScopedAudit is a violation: its stack trace is printed
+    to stderr the first time it is seen, and it is counted.
+*/
+namespace RealtimeAudit
+{
+    /** True if the hooks are compiled in. */
+    bool isAvailable() noexcept;
+
+    /** Resolves the hooked functions. Call once, before the first ScopedAudit. */
+    void initialise();
+
+    /** Number of violations since the start. */
+    int getNumViolations() noexcept;
+
+    /** Audits the calling thread during its lifetime. */
+    class ScopedAudit
+    {
+    public:
+        explicit ScopedAudit(bool shouldAudit = true) noexcept;
+        ~ScopedAudit() noexcept;
+
+    private:
+        bool wasAuditing;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedAudit)
+    };
+}
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    ScriptedPlayHead.h
+    Created: 16 Oct 2026 2:05:51pm
+    Author:  doare
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** A fake host transport that follows a fixed script, so that the processor
+    can be driven headless in a repeatable way.
+*/
+class ScriptedPlayHead : public juce::AudioPlayHead
+{
+public:
+    enum class Script
+    {
+        playing,      // Constant tempo, transport running
+        stopped,      // Transport stopped, the processor runs on its internal PPQ
+        loop,         // Transport jumps back to 0 every loopLengthInPpq
+        tempoChanges, // Tempo changes every 2 beats
+        startStop     // Transport starts and stops every 2 beats
+    };
+
+    static const juce::StringArray& getScriptNames()
+    {
+        static const juce::StringArray names { "playing", "stopped", "loop", "tempo", "startstop" };
+        return names;
+    }
+
+    ScriptedPlayHead(Script s, double sampleRate, double initialBpm = 120.0)
+        : script(s), currentSampleRate(sampleRate), startBpm(initialBpm)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        ppq = 0.0;
+        gatePpq = 0.0;
+        bpm = startBpm;
+        isPlaying = script != Script::stopped;
+        samplePosition = 0;
+        anchorSample = 0;
+        anchorPpq = 0.0;
+    }
+
+    juce::Optional<PositionInfo> getPosition() const override
+    {
+        PositionInfo info;
+        info.setBpm(bpm);
+        info.setPpqPosition(ppq);
+        info.setIsPlaying(isPlaying);
+        info.setTimeSignature(juce::AudioPlayHead::TimeSignature { 4, 4 });
+        return info;
+    }
+
+    double getBpm() const noexcept { return bpm; }
+
+    /** Returns the position the gate runs from during the next block: the host
+        position while playing, or the processor's internal position otherwise.
+    */
+    double getGatePpqForNextBlock() const noexcept { return isPlaying ? ppq : gatePpq; }
+
+    /** Moves the transport forward by one block. */
+    void advance(int numSamples)
+    {
+        // The processor adds up its own position block by block while stopped
+        gatePpq = getGatePpqForNextBlock() + numSamples * bpm / (currentSampleRate * 60.0);
+
+        // The transport position is derived from the number of samples since
+        // the last jump or tempo change, not added up block by block, so that
+        // it does not depend on the block size. startStop keeps time running
+        // while stopped so that the script progresses.
+        samplePosition += numSamples;
+        if (isPlaying || script == Script::startStop)
+            ppq = anchorPpq + (double) (samplePosition - anchorSample) * bpm / (currentSampleRate * 60.0);
+
+        const auto beat = (int) std::floor(ppq / 2.0);
+
+        switch (script)
+        {
+            case Script::loop:
+                if (ppq >= loopLengthInPpq)
+                    setAnchor(ppq - loopLengthInPpq);
+                break;
+
+            case Script::tempoChanges:
+            {
+                static constexpr double tempi[] { 90.0, 120.0, 174.0, 63.0 };
+                if (tempi[beat % 4] != bpm)
+                {
+                    setAnchor(ppq);
+                    bpm = tempi[beat % 4];
+                }
+                break;
+            }
+
+            case Script::startStop:
+                isPlaying = (beat % 2) == 0;
+                break;
+
+            case Script::playing:
+            case Script::stopped:
+                break;
+        }
+    }
+
+    static constexpr double loopLengthInPpq = 3.0;
+
+private:
+    void setAnchor(double newPpq) noexcept
+    {
+        ppq = newPpq;
+        anchorPpq = newPpq;
+        anchorSample = samplePosition;
+    }
+
+    Script script;
+    double currentSampleRate;
+    double startBpm;
+    double ppq = 0.0;
+    double gatePpq = 0.0;
+    double bpm = 120.0;
+    bool isPlaying = true;
+
+    // Position of the last jump or tempo change
+    juce::int64 samplePosition = 0;
+    juce::int64 anchorSample = 0;
+    double anchorPpq = 0.0;
+};